@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_reset.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 09:14:30 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 09:14:32 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/* Cost of ar_reset() after a command, for a few amounts of arena use, next
+to what clearing a whole chunk cost when every reset did that.
+*/
+
+/* Use the arena like a command that allocated about used bytes in small
+pieces
+*/
+static void	use_arena(t_arena *arena, size_t used)
+{
+	size_t	done;
+
+	done = 0;
+	while (done < used)
+	{
+		ar_alloc(arena, 64);
+		done += 64;
+	}
+}
+
+/* Time ar_reset() alone, the allocations before it are not counted
+*/
+static void	time_reset(char *label, size_t used)
+{
+	t_arena	*arena;
+	double	total;
+	double	start;
+	long	i;
+
+	arena = ar_init();
+	if (!arena)
+		return ;
+	total = 0;
+	i = 0;
+	while (i < RESET_ITERS)
+	{
+		use_arena(arena, used);
+		start = bench_ns();
+		ar_reset(arena);
+		total += bench_ns() - start;
+		i++;
+	}
+	bench_line(label, total / RESET_ITERS, "ns per reset");
+	free_arena(arena);
+}
+
+/* Time clearing one whole AR_MAX_CHUNK buffer, the old reset of a chunk
+*/
+static void	time_full_clear(void)
+{
+	char	*buf;
+	double	start;
+	long	i;
+
+	buf = malloc(AR_MAX_CHUNK);
+	if (!buf)
+		return ;
+	start = bench_ns();
+	i = 0;
+	while (i < RESET_ITERS / 100)
+	{
+		ft_bzero(buf, AR_MAX_CHUNK);
+		i++;
+	}
+	bench_line("clear a whole 2 MB chunk", (bench_ns() - start)
+		/ (RESET_ITERS / 100), "ns");
+	free(buf);
+}
+
+int	main(void)
+{
+	ft_printf("arena reset\n");
+	time_reset("after 256 B (echo hi)", 256);
+	time_reset("after 16 KB", 16384);
+	time_reset("after 1 MB", 1048576);
+	time_full_clear();
+	return (0);
+}
@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 09:12:05 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 09:12:07 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+# include "minishell.h"
+# include <time.h>
+
+# define RESET_ITERS 20000 // resets timed per arena size (arena_reset)
+# define LEX_SHORT_ITERS 200000 // times the short line is tokenized (lexer)
+# define LEX_LONG_ITERS 20 // times the long line is tokenized (lexer)
+# define LEX_LONG_SIZE 480000 // bytes of the long line (lexer)
+# define LEX_LONG_GROUP "plain_word \"quoted $HOME text\" 'single' x=y "
+# define LEX_SHORT_LINE "echo hello \"quoted $HOME world\" 'single quoted' \
+plain_word_here > out.txt | grep -v foo<<EOF a=b c=\"d e\" | wc -l >> log"
+# define SCAN_CHECK_STRINGS 200000 // random strings checked (scan_check)
+# define SCAN_CHECK_LEN 300 // longest of them
+# define SCAN_CHECK_PAGE 4096 // page size the guard pages assume
+# define EXPAND_CHECK_OUT 256 // room for the argv of a case (expand_check)
+# define ENV_NAMES 64 // names looked up, half of them missing (env_lookup)
+# define ENV_LOOKUP_ITERS 2000000 // lookups timed per table size
+# define ENV_SET_ITERS 2000 // sets timed per table size
+# define PATH_BENCH_ITERS 5000 // lookups per case (path_syscalls)
+# define PATH_BENCH_DIRS 15 // directories in PATH_BENCH_PATH
+# define PATH_BENCH_PATH "PATH=/usr/local/sbin:/usr/local/bin:/usr/sbin:\
+/opt/a/bin:/opt/b/bin:/opt/c/bin:/snap/bin:/usr/games:/usr/local/games:\
+/opt/d/bin:/opt/e/bin:/opt/f/bin:/opt/g/bin:/usr/bin:/bin"
+
+// Drivers linked against the objects of the shell, run with make bench
+double	bench_ns(void);
+void	bench_line(char *label, double value, char *unit);
+
+#endif
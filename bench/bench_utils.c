@@ -0,0 +1,31 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_utils.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 09:12:11 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 09:12:13 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/* Monotonic time in nanoseconds
+*/
+double	bench_ns(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1e9 + now.tv_nsec);
+}
+
+/* Print one result as "label: value unit", the value rounded to a whole
+number (ft_printf has no floating point)
+*/
+void	bench_line(char *label, double value, char *unit)
+{
+	ft_printf("  %s: %u %s\n", label, (unsigned int)(value + 0.5), unit);
+}
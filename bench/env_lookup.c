@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   env_lookup.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 11:05:52 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 11:05:54 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/* Cost of get_shell_env_value() and set_shell_env_value() for shells that
+inherited 10, 1000 and 100000 variables. Half of the names looked up
+exist, half do not.
+*/
+
+/* Return: prefix, n and suffix as one malloc'd string, NULL on errors
+*/
+static char	*name_string(char *prefix, int n, char *suffix)
+{
+	char	*num;
+	char	*head;
+	char	*str;
+
+	num = ft_itoa(n);
+	if (!num)
+		return (NULL);
+	head = ft_strjoin(prefix, num);
+	free(num);
+	if (!head)
+		return (NULL);
+	str = ft_strjoin(head, suffix);
+	free(head);
+	return (str);
+}
+
+/* count strings for a shell of n variables: its environment
+("VAR_<i>=value"), or the names to look up, every other one missing
+
+Return: NULL-terminated array, NULL on errors
+*/
+static char	**make_strings(int count, int n, int lookup)
+{
+	char	**strs;
+	int		i;
+
+	strs = ft_calloc(count + 1, sizeof(char *));
+	i = 0;
+	while (strs && i < count)
+	{
+		if (!lookup)
+			strs[i] = name_string("VAR_", i, "=value");
+		else if (i & 1)
+			strs[i] = name_string("VAR_", (i * 7919) % n, "");
+		else
+			strs[i] = name_string("MISS_", (i * 7919) % n, "");
+		if (!strs[i])
+			return (NULL);
+		i++;
+	}
+	return (strs);
+}
+
+static void	free_strings(char **strs)
+{
+	int	i;
+
+	i = 0;
+	while (strs && strs[i])
+	{
+		free(strs[i]);
+		i++;
+	}
+	free(strs);
+}
+
+/* Time iters lookups, then ENV_SET_ITERS sets, going round the names
+*/
+static void	time_ops(t_shell *shell, char **names, long iters)
+{
+	double	start;
+	long	found;
+	long	i;
+
+	found = 0;
+	start = bench_ns();
+	i = 0;
+	while (i < iters)
+	{
+		found += (get_shell_env_value(shell, names[i % ENV_NAMES]) != NULL);
+		i++;
+	}
+	bench_line("lookup", (bench_ns() - start) / iters, "ns");
+	start = bench_ns();
+	i = 0;
+	while (i < ENV_SET_ITERS)
+	{
+		set_shell_env_value(shell, names[i % ENV_NAMES], "v");
+		i++;
+	}
+	bench_line("set", (bench_ns() - start) / ENV_SET_ITERS, "ns");
+	if (found != iters / 2)
+		ft_printf("  (%d of the lookups found something)\n", (int)found);
+}
+
+int	main(void)
+{
+	static const int	sizes[3] = {10, 1000, 100000};
+	char				**env;
+	char				**names;
+	t_shell				*shell;
+	int					i;
+
+	i = 0;
+	while (i < 3)
+	{
+		env = make_strings(sizes[i], sizes[i], 0);
+		names = make_strings(ENV_NAMES, sizes[i], 1);
+		shell = NULL;
+		if (env && names)
+			shell = init_shell(0, NULL, env);
+		if (!shell)
+			return (1);
+		ft_printf("env lookup, %d variables\n", sizes[i]);
+		time_ops(shell, names, ENV_LOOKUP_ITERS);
+		free_shell(shell);
+		free_strings(env);
+		free_strings(names);
+		i++;
+	}
+	return (0);
+}
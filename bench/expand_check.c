@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   expand_check.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/18 09:42:11 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/18 09:42:13 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/* Check of the argument vectors the parser builds from words that expand
+to nothing: an unquoted one is dropped, a quoted one ("", "$NOPE", $"",
+$'') stays as an empty argument, and none of them ends argv early.
+Each case is a line and its expected argv, every argument in brackets.
+*/
+
+/* Put the arguments of the first command of line in out, each in brackets
+
+Return: 0 on success, -1 when the line does not parse
+*/
+static int	parse_argv(t_shell *shell, char *line, char *out)
+{
+	t_token_list	*tokens;
+	t_cmd_table		*table;
+	int				i;
+
+	out[0] = '\0';
+	tokens = tokenize_input(shell, line);
+	table = ar_alloc(shell->arena, sizeof(t_cmd_table));
+	if (!tokens || !table || register_to_table(shell, tokens, table) != 0
+		|| !table->list_of_cmds)
+		return (-1);
+	i = 0;
+	while (table->list_of_cmds->cmd_av[i])
+	{
+		ft_strlcat(out, "[", EXPAND_CHECK_OUT);
+		ft_strlcat(out, table->list_of_cmds->cmd_av[i], EXPAND_CHECK_OUT);
+		ft_strlcat(out, "]", EXPAND_CHECK_OUT);
+		i++;
+	}
+	return (0);
+}
+
+/* Parse the line and compare its argv with want
+
+Return: 1 on a mismatch, 0 otherwise
+*/
+static int	check_case(t_shell *shell, char *line, char *want)
+{
+	char	got[EXPAND_CHECK_OUT];
+	int		bad;
+
+	bad = (parse_argv(shell, line, got) == -1 || ft_strcmp(got, want) != 0);
+	if (bad)
+		ft_printf("  %s: got %s, want %s\n", line, got, want);
+	ar_reset(shell->arena);
+	return (bad);
+}
+
+int	main(void)
+{
+	static char	*cases[] = {"echo $\"\" a", "[echo][][a]",
+		"echo $'' b", "[echo][][b]", "echo \"\" a", "[echo][][a]",
+		"echo \"$NOPE\" a", "[echo][][a]", "echo $NOPE a", "[echo][a]",
+		"echo x$NOPE\"\" d", "[echo][x][d]",
+		"echo $\"\" $'' \"$NOPE\" z", "[echo][][][][z]", NULL};
+	static char	*env[] = {"HOME=/tmp", NULL};
+	t_shell		*shell;
+	int			bad;
+	int			i;
+
+	shell = init_shell(0, NULL, env);
+	if (!shell)
+		return (1);
+	bad = 0;
+	i = 0;
+	while (cases[i])
+	{
+		bad += check_case(shell, cases[i], cases[i + 1]);
+		i += 2;
+	}
+	ft_printf("expansion: %d cases, %d mismatches\n", i / 2, bad);
+	free_shell(shell);
+	return (bad != 0);
+}
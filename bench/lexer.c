@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lexer.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:02:41 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 10:02:43 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/* Throughput of tokenize_input() on a typical command line and on one very
+long line of quoted and plain words. The arena is reset after every line,
+as the shell does.
+*/
+
+/* Tokenize line iters times and print the throughput
+*/
+static void	time_lexer(t_shell *shell, char *label, char *line, long iters)
+{
+	double	start;
+	double	bytes;
+	long	i;
+
+	bytes = ft_strlen(line) * (double)iters;
+	start = bench_ns();
+	i = 0;
+	while (i < iters)
+	{
+		if (!tokenize_input(shell, line))
+			return ;
+		ar_reset(shell->arena);
+		i++;
+	}
+	bench_line(label, bytes / ((bench_ns() - start) / 1e9) / 1e6, "MB/s");
+}
+
+/* Build a line of about size bytes out of one repeated group of words
+*/
+static char	*long_line(char *group, size_t size)
+{
+	char	*line;
+	size_t	len;
+	size_t	used;
+
+	len = ft_strlen(group);
+	line = malloc(size + len + 1);
+	if (!line)
+		return (NULL);
+	used = 0;
+	while (used < size)
+	{
+		ft_memcpy(line + used, group, len);
+		used += len;
+	}
+	line[used] = '\0';
+	return (line);
+}
+
+int	main(int ac, char **av, char **env)
+{
+	t_shell	*shell;
+	char	*line;
+
+	shell = init_shell(ac, av, env);
+	if (!shell)
+		return (1);
+	ft_printf("lexer\n");
+	time_lexer(shell, "119-byte line", LEX_SHORT_LINE, LEX_SHORT_ITERS);
+	line = long_line(LEX_LONG_GROUP, LEX_LONG_SIZE);
+	if (line)
+		time_lexer(shell, "480 KB line", line, LEX_LONG_ITERS);
+	free(line);
+	free_shell(shell);
+	return (0);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_syscalls.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 11:48:09 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 11:48:11 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+#include <stdarg.h>
+
+/* Cost of find_executable() in time and in stat(), fstatat() and open()
+calls, on a PATH of PATH_BENCH_DIRS directories of which only some exist.
+The three calls are counted by wrapping them at link time (the Makefile
+links this driver with -Wl,--wrap=stat,--wrap=fstatat,--wrap=open).
+*/
+
+static long	g_calls[3];
+
+int	__real_stat(const char *path, t_stat *st);
+int	__real_fstatat(int dirfd, const char *path, t_stat *st, int flags);
+int	__real_open(const char *path, int flags, ...);
+
+int	__wrap_stat(const char *path, t_stat *st)
+{
+	g_calls[0]++;
+	return (__real_stat(path, st));
+}
+
+int	__wrap_fstatat(int dirfd, const char *path, t_stat *st, int flags)
+{
+	g_calls[1]++;
+	return (__real_fstatat(dirfd, path, st, flags));
+}
+
+int	__wrap_open(const char *path, int flags, ...)
+{
+	va_list	args;
+	int		mode;
+
+	va_start(args, flags);
+	mode = va_arg(args, int);
+	va_end(args);
+	g_calls[2]++;
+	return (__real_open(path, flags, mode));
+}
+
+/* Look a command up PATH_BENCH_ITERS times
+- missing: a new name every time, so nothing is hashed and every
+  directory is probed
+- rehash: the hash is emptied first (hash -r), the directories are
+  opened again
+- otherwise: the same name, found in the hash
+
+Return: time per lookup, in ns
+*/
+static double	run(t_shell *shell, int missing, int rehash)
+{
+	t_ar_mark	mark;
+	t_stat		st;
+	double		start;
+	long		i;
+
+	start = bench_ns();
+	i = 0;
+	while (i < PATH_BENCH_ITERS)
+	{
+		mark = ar_mark(shell->arena);
+		if (rehash)
+			clear_cmd_hash(shell);
+		drain_path_events(shell);
+		if (missing)
+			find_executable(shell, ar_strjoin(shell->arena, "nx",
+					ar_itoa(shell->arena, i)), &st);
+		else
+			find_executable(shell, "true", &st);
+		ar_rollback(shell->arena, mark);
+		i++;
+	}
+	return ((bench_ns() - start) / PATH_BENCH_ITERS);
+}
+
+int	main(void)
+{
+	static char	*cases[3] = {"hit (true)", "miss, not in PATH",
+		"after hash -r (true)"};
+	static char	*env[3] = {"HOME=/root", PATH_BENCH_PATH, NULL};
+	t_shell		*shell;
+	t_stat		st;
+	int			i;
+
+	shell = init_shell(0, NULL, env);
+	if (!shell || !find_executable(shell, "true", &st))
+		return (1);
+	ft_printf("PATH lookup, %d directories\n", PATH_BENCH_DIRS);
+	i = 0;
+	while (i < 3)
+	{
+		ft_bzero(g_calls, sizeof(g_calls));
+		ft_printf(" %s\n", cases[i]);
+		bench_line("time", run(shell, i == 1, i == 2), "ns");
+		bench_line("stat", g_calls[0] / (double)PATH_BENCH_ITERS, "per lookup");
+		bench_line("fstatat", g_calls[1] / (double)PATH_BENCH_ITERS,
+			"per lookup");
+		bench_line("open", g_calls[2] / (double)PATH_BENCH_ITERS, "per lookup");
+		i++;
+	}
+	free_shell(shell);
+	return (0);
+}
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# Prompt latency of an interactive minishell, run on a pseudo terminal.
+#
+# PATH gets a few large directories of fake commands in front of the usual
+# ones, so the command index (see build_cmd_index()) has real work to do.
+# For each idle time, the shell is started, the prompt waited for, then
+# after the idle time a command name is typed and completed with Tab:
+#   prompt    - from exec to the first prompt, indexing must not delay it
+#   first Tab - from Tab to the bell (ten commands match), short once
+#               the index is built
+#
+# usage: prompt_latency.py [minishell ...]  (default ./minishell)
+# Give an older build as a second binary to compare the two.
+
+import os
+import pty
+import select
+import shutil
+import statistics
+import sys
+import tempfile
+import time
+
+DIRS = 6
+CMDS_PER_DIR = 1000
+RUNS = 9
+IDLE = (0.0, 0.25, 0.5, 1.0)
+WORD = b'tool5_09'
+
+
+def make_path(root):
+    dirs = []
+    for d in range(DIRS):
+        path = os.path.join(root, 'd%d' % d)
+        os.mkdir(path)
+        for c in range(CMDS_PER_DIR):
+            name = os.path.join(path, 'tool%d_%03d' % (d, c))
+            with open(name, 'w') as f:
+                f.write('#!/bin/sh\n')
+            os.chmod(name, 0o755)
+        dirs.append(path)
+    return ':'.join(dirs + ['/usr/local/bin', '/usr/bin', '/bin'])
+
+
+def read_until(fd, pattern, timeout=5):
+    buf = b''
+    end = time.time() + timeout
+    while time.time() < end:
+        ready, _, _ = select.select([fd], [], [], 0.01)
+        if ready:
+            buf += os.read(fd, 65536)
+            if pattern in buf:
+                break
+    return buf
+
+
+def once(binary, path, idle):
+    start = time.perf_counter()
+    pid, fd = pty.fork()
+    if pid == 0:
+        os.environ['PATH'] = path
+        os.execv(binary, [binary])
+    read_until(fd, b'> ')
+    prompt = time.perf_counter() - start
+    time.sleep(idle)
+    os.write(fd, WORD)
+    read_until(fd, WORD)
+    start = time.perf_counter()
+    os.write(fd, b'\t')
+    read_until(fd, b'\x07')
+    tab = time.perf_counter() - start
+    os.write(fd, b'\x15exit\n')
+    read_until(fd, b'exit\r\n')
+    os.waitpid(pid, 0)
+    os.close(fd)
+    return prompt, tab
+
+
+def main():
+    binaries = sys.argv[1:] or ['./minishell']
+    root = tempfile.mkdtemp(prefix='prompt_latency.')
+    try:
+        path = make_path(root)
+        for binary in binaries:
+            for idle in IDLE:
+                res = [once(binary, path, idle) for _ in range(RUNS)]
+                print('%-24s idle %.2f s: prompt %7.2f ms  first Tab %7.2f ms'
+                      % (binary, idle,
+                         statistics.median(r[0] for r in res) * 1e3,
+                         statistics.median(r[1] for r in res) * 1e3))
+    finally:
+        shutil.rmtree(root)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan_check.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:31:17 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/13 10:31:19 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+#include <sys/mman.h>
+
+/* Differential check of the scan kernels: the SSE2 and AVX2 kernels and
+scan_until() must give the same answer as scan_scalar() on random strings
+of every length up to SCAN_CHECK_LEN and every alignment. The strings sit
+either right before an inaccessible page or right after one, so a kernel
+that reads across a page boundary past the NUL crashes the check.
+*/
+
+/* One page of memory with an inaccessible page on both sides
+
+Return: start of the usable page, NULL on errors
+*/
+static char	*guarded_page(void)
+{
+	char	*map;
+
+	map = mmap(NULL, SCAN_CHECK_PAGE * 3, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return (NULL);
+	if (mprotect(map, SCAN_CHECK_PAGE, PROT_NONE)
+		|| mprotect(map + SCAN_CHECK_PAGE * 2, SCAN_CHECK_PAGE, PROT_NONE))
+		return (NULL);
+	return (map + SCAN_CHECK_PAGE);
+}
+
+/* Fill s with len random letters, some of them replaced by bytes that stop
+one set or another, then the NUL. density sets how often that happens.
+*/
+static void	fill_string(char *s, int len, int density)
+{
+	static const char	special[] = "ab \t\n\"'$&<>|xyz\x80\xff";
+	int					i;
+
+	i = 0;
+	while (i < len)
+	{
+		s[i] = 'a' + rand() % 26;
+		if (rand() % density == 0)
+			s[i] = special[rand() % (sizeof(special) - 1)];
+		i++;
+	}
+	s[len] = '\0';
+}
+
+/* Compare every kernel the CPU has with scan_scalar() on s, for every set
+
+Return: number of mismatches
+*/
+static int	check_string(char *s, int level)
+{
+	static const char	*stops[SCAN_SETS + 1] = {SCAN_WORD_STOPS,
+		SCAN_QUOTED_STOPS, SCAN_EXPAND_STOPS, SCAN_DOLLAR_STOPS, ""};
+	size_t				want;
+	int					bad;
+	int					set;
+
+	bad = 0;
+	set = 0;
+	while (set <= SCAN_SETS)
+	{
+		want = scan_scalar(s, stops[set]);
+		if (level >= 1 && scan_sse2(s, stops[set]) != want)
+			bad++;
+		if (level >= 2 && scan_avx2(s, stops[set]) != want)
+			bad++;
+		if (set < SCAN_SETS && scan_until(s, (t_scan_set)set) != want)
+			bad++;
+		set++;
+	}
+	return (bad);
+}
+
+/* Put a random string at the end of the page or at a random offset near
+its start, and check it
+
+Return: number of mismatches
+*/
+static int	check_random(char *page, int level)
+{
+	char	*s;
+	int		len;
+
+	len = rand() % SCAN_CHECK_LEN;
+	s = page + rand() % 64;
+	if (rand() & 1)
+		s = page + SCAN_CHECK_PAGE - len - 1;
+	fill_string(s, len, rand() % 40 + 1);
+	return (check_string(s, level));
+}
+
+int	main(void)
+{
+	char	*page;
+	long	i;
+	long	bad;
+	int		level;
+
+	page = guarded_page();
+	if (!page)
+		return (1);
+	level = scan_cpu_level();
+	srand(42);
+	bad = 0;
+	i = 0;
+	while (i < SCAN_CHECK_STRINGS)
+	{
+		bad += check_random(page, level);
+		i++;
+	}
+	ft_printf("scan kernels (cpu level %d): %d strings, %d mismatches\n",
+		level, SCAN_CHECK_STRINGS, (int)bad);
+	return (bad != 0);
+}
@@ -13,30 +13,119 @@
 #ifndef ARENA_H
 # define ARENA_H
 
-# define AR_SIZE 2097152 // 2MB
+# define AR_FIRST_SIZE 16384 // 16KB, size of the first chunk
+# define AR_MAX_CHUNK 2097152 // 2MB, chunks stop doubling at this size
+# define AR_LARGE 262144 // 256KB, from here requests get a dedicated block
+# define AR_STR_MIN 16 // first capacity of a string builder
+# define AR_TRIM_WINDOW 16 // default number of commands trimming looks at
+# define AR_TRIM_MAX 64 // largest trim window (see ar_set_trim_window())
+
+// Parts of the shell that allocation is attributed to (see ar_set_phase())
+typedef enum e_ar_phase
+{
+	AR_TOKENIZE,
+	AR_PARSE,
+	AR_EXPAND,
+	AR_HEREDOC,
+	AR_EXEC,
+	AR_PHASES
+}	t_ar_phase;
+
+typedef struct s_ar_chunk
+{
+	char				*buffer; // pointer to start of the chunk memory
+	size_t				size; // the size of the chunk
+	size_t				offset; // start of free space, also the used high-water
+	struct s_ar_chunk	*next; // pointer to the next (bigger) chunk
+}	t_ar_chunk;
+
+typedef struct s_ar_large
+{
+	struct s_ar_large	*next; // next dedicated block, freed on reset
+	size_t				size; // payload size, payload follows this header
+}	t_ar_large;
+
+typedef struct s_ar_mark
+{
+	t_ar_chunk	*chunk; // chunk the cursor was on
+	size_t		offset; // its offset at that time
+	t_ar_large	*large; // newest large block at that time
+}	t_ar_mark;
+
+typedef struct s_ar_str
+{
+	char	*buf; // NULL until something is added, always NUL-terminated
+	size_t	len; // bytes in use, not counting the NUL
+	size_t	cap; // bytes reserved for buf, including the NUL
+}	t_ar_str;
+
+typedef struct s_ar_stats
+{
+	size_t	allocs; // number of ar_alloc() calls in the session
+	size_t	requested; // bytes asked for by callers in the session
+	size_t	aligned; // same after rounding up to 8 bytes
+	size_t	phase[AR_PHASES]; // aligned bytes attributed to each phase
+	size_t	live; // aligned bytes the current command holds right now
+	size_t	cmd_peak; // highest live value of the current command
+	size_t	last_peak; // cmd_peak of the previous command
+	size_t	max_peak; // highest cmd_peak seen in the session
+	size_t	commands; // prompt lines finished (arena resets)
+}	t_ar_stats;
 
 typedef struct s_arena
 {
-	void			*buffer; // pointer to start of arena
-	size_t			size; // the size of the arena
-	size_t			offset; // tracking the start of free space
-	struct s_arena	*next; // pointer to the next arena
+	t_ar_chunk	*head; // first (smallest) chunk, kept for the whole session
+	t_ar_chunk	*current; // chunk allocations are bumped from
+	t_ar_large	*large; // oversized requests living outside the chunks
+	int			used[AR_TRIM_MAX]; // chunks used by the last commands
+	int			used_slot; // where the next command's usage is recorded
+	int			trim_window; // how many of used[] the trimming looks at
+	t_ar_phase	phase; // phase new allocations are attributed to
+	t_ar_stats	stats; // usage counters, printed by memstats
 }	t_arena;
 
 // Arena core functions
-t_arena	*ar_init(void);
-void	*ar_alloc(t_arena *arena, size_t bytes);
-int		normally_fit_in_arena(t_arena *arena, void **ptr, size_t *bytes);
-void	free_arena(t_arena *arena);
-void	ar_reset(t_arena *arena);
+t_arena		*ar_init(void);
+void		*ar_alloc(t_arena *arena, size_t bytes);
+void		free_arena(t_arena *arena);
+void		ar_reset(t_arena *arena);
+
+// Arena chunk management
+t_ar_chunk	*ar_new_chunk(size_t size);
+void		*ar_alloc_next_chunk(t_arena *arena, size_t bytes);
+void		*ar_alloc_large(t_arena *arena, size_t bytes);
+void		ar_free_large(t_arena *arena);
+void		ar_trim_chunks(t_arena *arena);
+void		ar_set_trim_window(t_arena *arena, int window);
+int			ar_extend(t_arena *arena, void *ptr, size_t old_size,
+				size_t new_size);
+
+// Arena scopes for transient work
+t_ar_mark	ar_mark(t_arena *arena);
+void		ar_rollback(t_arena *arena, t_ar_mark mark);
+char		*ar_rollback_keep(t_arena *arena, t_ar_mark mark, char *keep);
+
+// Arena instrumentation
+t_ar_phase	ar_set_phase(t_arena *arena, t_ar_phase phase);
+void		ar_count(t_arena *arena, size_t requested, size_t aligned);
+void		ar_count_bytes(t_arena *arena, size_t requested, size_t aligned);
+void		ar_uncount(t_arena *arena, size_t aligned);
+void		ar_stats_end_command(t_arena *arena);
+void		ar_stats_print(t_arena *arena, int fd);
+
+// Arena string builder
+int			ar_str_reserve(t_arena *arena, t_ar_str *str, size_t extra);
+int			ar_str_putc(t_arena *arena, t_ar_str *str, char c);
+int			ar_str_putn(t_arena *arena, t_ar_str *str, const char *s,
+				size_t n);
+int			ar_str_puts(t_arena *arena, t_ar_str *str, const char *s);
 
 // Arena utility functions
-char	*ar_strdup(t_arena *arena, const char *str);
-char	*ar_substr(t_arena *arena, const char *s, unsigned int start,
-			size_t len);
-char	*ar_strjoin(t_arena *arena, const char *s1, const char *s2);
-char	**ar_split(t_arena *arena, const char *s, char c);
-char	*ar_itoa(t_arena *arena, int n);
-char	*ar_add_char_to_str(t_arena *arena, char *s, char c);
+char		*ar_strdup(t_arena *arena, const char *str);
+char		*ar_substr(t_arena *arena, const char *s, unsigned int start,
+				size_t len);
+char		*ar_strjoin(t_arena *arena, const char *s1, const char *s2);
+char		**ar_split(t_arena *arena, const char *s, char c);
+char		*ar_itoa(t_arena *arena, int n);
 
 #endif
@@ -13,6 +13,30 @@
 #ifndef EXE_H
 # define EXE_H
 
+# define MEMSTATS_ENV "MINISHELL_MEMSTATS" // file memstats appends to at exit
+# define LAUNCHER_ENV "MINISHELL_LAUNCHER" // if set, commands use a launcher
+# define TRIM_WINDOW_ENV "MINISHELL_TRIM_WINDOW" // commands arena trim looks at
+# define LAUNCH_FDS 4 // sent with a request: stdin, stdout, stderr, cwd
+# define OUT_BUF_SIZE 4096 // output buffer of a builtin, on its stack
+# define VAR_FIRST_CAP 64 // variables the table starts with, doubles
+# define VAR_MIN_SLOTS 128 // smallest variable hash index, a power of two
+# define VAR_EMPTY -1 // hash slot never used
+# define VAR_GONE -2 // hash slot of a variable that was unset
+# define CMD_HASH_MIN_SLOTS 32 // smallest command hash, a power of two
+# define CMD_INDEX_MIN_NODES 1024 // nodes the command index starts with
+# define CMD_INDEX_SLICE 256 // directory entries indexed per idle call
+# define CMD_INDEX_POLL_US 10000 // readline idle poll while indexing
+# define RL_POLL_US 100000 // readline's own idle poll
+// what is_builtin() accepts, offered by tab completion
+# define BUILTIN_NAMES "cd echo pwd env export unset exit memstats hash"
+
+// open() flags of the PATH directories, only searched in
+# ifdef O_PATH
+#  define DIR_FD_FLAGS (O_PATH | O_DIRECTORY | O_CLOEXEC)
+# else
+#  define DIR_FD_FLAGS (O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+# endif
+
 // Type aliases for 42 norm compliance
 typedef struct stat			t_stat;
 typedef struct s_cmd_table	t_cmd_table;
@@ -20,6 +44,12 @@ typedef struct s_cmd		t_cmd;
 typedef struct s_redir		t_redir;
 typedef struct s_shell		t_shell;
 typedef struct s_var		t_var;
+typedef struct s_export		t_export;
+typedef struct s_cmd_index	t_cmd_index;
+typedef struct s_match_list	t_match_list;
+typedef struct s_spawn		t_spawn;
+typedef struct s_launch_req	t_launch_req;
+typedef struct s_outbuf		t_outbuf;
 
 // Main execution dispatcher
 int		exe_cmd(t_shell *shell, t_cmd_table *cmd_table);
@@ -27,49 +57,75 @@ int		exe_single_cmd(t_shell *shell, t_cmd *cmd);
 int		exe_builtin_with_fork(t_cmd *cmd, t_shell *shell);
 int		is_non_forkable_builtin(char *cmd_name);
 int		exe_external_cmd(t_shell *shell, t_cmd *cmd);
-int		exe_redirection_only(t_shell *shell, t_cmd *cmd);
+int		exe_redirection_only(t_cmd *cmd);
 int		dispatch_builtin(t_cmd *cmd, t_shell *shell);
+int		exe_builtin_in_shell(t_cmd *cmd, t_shell *shell);
 
 // Built-in command detection and dispatch
 int		is_builtin(char *cmd);
 int		exe_builtin(t_cmd *cmd, t_shell *shell);
 
 // Individual built-in implementations
-int		builtin_echo(t_cmd *cmd);
+int		builtin_echo(t_cmd *cmd, int fd);
 int		nl_flag_acceptable(char *cmd_av, int *newline);
-int		builtin_pwd(t_cmd *cmd);
+int		builtin_pwd(t_cmd *cmd, int fd);
 int		builtin_cd(t_shell *shell, t_cmd *cmd);
-int		builtin_env(t_shell *shell);
+int		builtin_env(char **env, int fd);
 int		builtin_export(t_shell *shell, t_cmd *cmd);
 int		builtin_unset(t_shell *shell, t_cmd *cmd);
 int		builtin_exit(t_shell *shell, t_cmd *cmd);
+int		builtin_memstats(t_shell *shell);
+int		builtin_hash(t_shell *shell, t_cmd *cmd);
+void	out_init(t_outbuf *out, int fd);
+int		out_flush(t_outbuf *out);
+void	out_mem(t_outbuf *out, const char *s, size_t len);
+void	out_str(t_outbuf *out, const char *s);
+void	memstats_at_exit(t_shell *shell);
 
 // Export helper functions
-int		copy_vars_fr_env_to_export_list(t_shell *shell);
-int		plain_export(t_shell *shell);
+int		plain_export(t_shell *shell, t_arena *arena, int fd);
 int		export_this_var(t_shell *shell, char *arg);
-int		find_name_and_value(t_shell *shell, char *arg, t_var **var);
-int		this_is_name(t_shell *shell, char *arg, size_t *i, t_var **var);
-int		this_is_value(t_shell *shell, char *arg, size_t *i, t_var **var);
-int		copy_var_fr_arena_to_shell(t_var *arena_var, t_var *shell_var);
-int		register_to_shell_vars(t_shell *shell, t_var *var);
-int		destined_to_be_first(t_shell *shell, t_var *var);
-int		update_this_fella(t_var *var, t_var *find, t_var *behind);
+int		find_name_and_value(t_shell *shell, char *arg, t_export **var);
+int		this_is_name(t_shell *shell, char *arg, size_t *i, t_export **var);
+int		this_is_value(t_shell *shell, char *arg, size_t *i, t_export **var);
 
 // Unset helper functions
 int		unset_this_var(t_shell *shell, char *input);
-void	unset_from_shell_vars(t_shell *shell, char *name);
-void	perform_exorcism_on_doppelganger(t_shell *shell, char *name);
 
 // Executable path resolution
-char	*find_executable(t_shell *shell, char *cmd);
-int		is_executable(char *path);
-int		is_regular_file(char *path);
-int		is_directory(char *path);
+char	*find_executable(t_shell *shell, char *cmd, t_stat *st);
+char	*find_cmd_executable(t_shell *shell, t_cmd *cmd, t_stat *st);
+char	*hashed_executable(t_shell *shell, char *cmd, int count_hit,
+			t_stat *st);
+int		open_path_dirs(t_shell *shell);
+void	close_path_dirs(t_shell *shell);
+int		path_dir_gone(t_shell *shell);
+char	*probe_path_dirs(t_shell *shell, char *cmd, t_stat *st, int *dir);
+void	watch_path_dirs(t_shell *shell);
+void	unwatch_path_dirs(t_shell *shell);
+void	drain_path_events(t_shell *shell);
 char	*build_path(t_shell *shell, char *dir, char *file);
 
 // Process creation and management
+pid_t	spawn_cmd(t_shell *shell, t_cmd *cmd, char *path, t_spawn *sp);
+pid_t	spawn_stage(t_shell *shell, t_cmd *cmd, int stage);
+char	*spawn_failed(t_shell *shell, t_cmd *cmd, t_spawn *sp, int retry);
+int		add_redir_actions(t_shell *shell, t_cmd *cmd, t_spawn *sp);
+int		open_redir_fd(t_redir *redir, t_cmd *cmd);
+void	redir_error(t_redir *redir, t_cmd *cmd);
+int		add_pipe_actions(t_shell *shell, t_spawn *sp, int stage);
+void	end_spawn(t_spawn *sp);
+void	start_launcher(t_shell *shell);
+void	stop_launcher(t_shell *shell);
+pid_t	launch_cmd(t_shell *shell, char *path, char **av, t_spawn *sp);
+char	**recv_request(int sock, t_launch_req *head, int *fds);
+int		read_all(int fd, void *buf, size_t size);
 void	execute_child_process(t_shell *shell, t_cmd *cmd, char *path);
+int		validate_executable_path(char *cmd_name, char *path, t_stat *st);
+int		is_thread_stage(t_cmd *cmd);
+int		start_thread_stage(t_shell *shell, t_cmd *cmd, int stage);
+void	start_thread_stages(t_shell *shell, t_cmd_table *cmd_table);
+int		join_thread_stage(t_shell *shell, int stage);
 int		wait_and_get_status(pid_t pid);
 
 // Redirection handling
@@ -79,6 +135,7 @@ int		handle_output_redirection(char *filename, int append);
 
 // Pipeline execution
 void	execute_pipeline(t_shell *shell, t_cmd_table *cmd_table);
+void	fork_pipeline_child(t_shell *shell, t_cmd *cmd, int i, int cmd_count);
 int		**alloc_pipe_array(t_shell *shell, int cmd_count);
 void	wait_all_children(t_shell *shell, int cmd_count);
 void	close_unused_pipes(t_shell *shell, int pipes_to_close);
@@ -86,9 +143,7 @@ void	close_unused_pipes(t_shell *shell, int pipes_to_close);
 // Shell initialization and management
 t_shell	*init_shell(int ac, char **av, char **env);
 void	free_shell(t_shell *shell);
-void	free_list_of_vars(t_var **var);
-void	free_1_var(t_var **var);
-void	free_partial_env(t_shell *shell, int count);
+void	free_var_store(t_shell *shell);
 
 // Shell environment management
 char	*get_shell_env_value(t_shell *shell, char *name);
@@ -99,15 +154,47 @@ int		unset_shell_env_value(t_shell *shell, char *name);
 char	*create_env_string(char *name, char *value);
 void	print_error(char *prefix, char *cmd, char *msg);
 int		find_env_index(t_shell *shell, char *name);
-int		resize_env_if_needed(t_shell *shell);
 int		update_shell_cwd(t_shell *shell, char *old_dir);
 
+// Variable table (see var_store.c, var_index.c, shell_env.c, env_overlay.c)
+int		var_store_add(t_shell *shell, char *entry, int name_len,
+			int equal_sign);
+int		var_store_set_value(t_shell *shell, int pos, char *value);
+char	**shell_env(t_shell *shell);
+int		apply_env_overlay(t_shell *shell, t_cmd *cmd);
+int		push_env_overlay(t_shell *shell, t_cmd *cmd, char ***saved);
+void	pop_env_overlay(t_shell *shell, char **saved);
+int		var_index_slot(t_shell *shell, char *name, int len);
+void	var_index_add(t_shell *shell, int pos);
+int		var_index_reserve(t_shell *shell, int cap);
+void	var_index_fill(t_shell *shell);
+
+// Command hash (see cmd_hash.c, path_hash.c, path_dirs.c, path_watch.c,
+// path_events.c)
+int		cmd_hash_find(t_shell *shell, char *name);
+int		cmd_hash_store(t_shell *shell, char *name, char *path, int dir);
+void	clear_cmd_hash(t_shell *shell);
+int		cmd_hash_current(t_shell *shell);
+void	forget_hashed(t_shell *shell, char *name);
+
+// Command name completion (see cmd_trie.c, cmd_index.c, completion.c,
+// completion_matches.c)
+int		trie_child(t_cmd_index *index, int parent, char c, int create);
+int		trie_insert(t_cmd_index *index, const char *name, int len);
+int		trie_reset(t_cmd_index *index);
+void	clear_cmd_index(t_cmd_index *index);
+int		build_cmd_index(t_shell *shell, int budget);
+char	**complete_command(t_cmd_index *index, const char *text);
+void	init_completion(t_shell *shell);
+int		index_idle_hook(void);
+
 // Heredoc utilities
 int		handle_heredocs(t_shell *shell, t_cmd_table *cmd_table);
 int		handle_heredoc_file(char *heredoc_filename);
 int		process_heredoc_input(t_shell *shell, t_redir *redir, char *filename);
 int		collect_heredoc_input(t_shell *shell, t_redir *redir, int fd);
-int		expand_dollar_sign(t_shell *shell, char *input, size_t *i, char **text);
+int		expand_dollar_sign(t_shell *shell, char *input, size_t *i,
+			t_ar_str *text);
 char	*generate_filename(t_shell *shell);
 
 //	Heredoc functions
@@ -115,7 +202,8 @@ char	*expand_heredoc_line(t_shell *shell, char *line);
 char	*generate_filename(t_shell *shell);
 int		write_heredoc_line(int fd, char *line);
 char	*special_heredoc_delimiter(t_arena *arena, char *delimiter);
-int		parse_special_delimiter(t_arena *arena, char *delimiter, char **result);
+int		parse_special_delimiter(t_arena *arena, char *delimiter,
+			t_ar_str *result);
 int		check_delimiter_match(char *line, char *delimiter);
 void	cleanup_heredoc_files(t_cmd_table *cmd_table);
 
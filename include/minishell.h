@@ -19,8 +19,13 @@
 # include <termios.h>   // terminal attributes
 # include <time.h>     // time sleep usleep
 # include <errno.h>    // ENOENT
+# include <stdint.h>   // uintptr_t
 # include <sys/wait.h> // wait, waitpid
 # include <sys/stat.h> // stat lstat fstat
+# include <dirent.h>   // opendir readdir closedir
+# include <spawn.h>    // posix_spawn
+# include <sys/socket.h> // socketpair sendmsg recvmsg
+# include <pthread.h>    // builtin stages of a pipeline
 # include <readline/readline.h> // readline()
 # include <readline/history.h> // add_history()
 # include "arena.h"			// memory arena
@@ -29,6 +34,12 @@
 
 extern volatile sig_atomic_t	g_signal;
 
+extern const unsigned char		g_char_class[256];
+
+// scan_until(): bytes checked with the class table before a kernel is used
+# define SCAN_PREFIX 16
+# define SCAN_MAX_STOPS 12 // most stop bytes a kernel handles, plus the NUL
+
 // Token types
 typedef enum e_token_type
 {
@@ -41,13 +52,83 @@ typedef enum e_token_type
 	TOKEN_EOF
 }	t_token_type;
 
-typedef struct s_tokens
+// Token flags
+# define TOK_QUOTED 1 // had quotes, needed check for the heredoc expansions
+# define TOK_EXPANDS 2 // has $ or &, value is raw until expansion
+# define TOK_ASSIGN 4 // starts with an unquoted NAME=, an assignment word
+# define TOK_FIRST_CAP 16 // tokens the array starts with, doubles when full
+# define ARGV_FIRST_CAP 8 // pointers a command's argv starts with, doubles
+
+typedef struct s_token
 {
 	t_token_type	type;
-	char			*value;	
-	int				was_quoted; // needed check for the heredoc expansions
-	struct s_tokens	*next;
-}	t_tokens;
+	int				flags;
+	int				off; // value starts at text + off, NUL-terminated
+	int				len; // length of the value
+}	t_token;
+
+// All tokens of one input line, in one array
+typedef struct s_token_list
+{
+	t_token	*items;
+	int		count;
+	int		cap;
+	int		pos; // index of the token the parser is working on
+	char	*text; // values of the tokens, each followed by a NUL
+	int		text_len; // bytes of text in use
+}	t_token_list;
+
+// Character classes of the lexer, everything from CC_SPACE on ends a word
+typedef enum e_char_class
+{
+	CC_WORD,
+	CC_DOLLAR,
+	CC_AMP,
+	CC_SQUOTE,
+	CC_DQUOTE,
+	CC_SPACE,
+	CC_PIPE,
+	CC_LESS,
+	CC_GREAT,
+	CC_END
+}	t_char_class;
+
+// Stop sets of scan_until(), as stop bytes and as masks of char classes.
+// SCAN_QUOTED right after SCAN_WORD: the lexer picks with (quote != 0)
+typedef enum e_scan_set
+{
+	SCAN_WORD,
+	SCAN_QUOTED,
+	SCAN_EXPAND,
+	SCAN_DOLLAR,
+	SCAN_SETS
+}	t_scan_set;
+
+// Lexer outside quotes: anything but a word character
+# define SCAN_WORD_STOPS " \t\n\"'$&<>|"
+# define SCAN_WORD_MASK 0x3FE
+// Lexer inside quotes: quotes, $ and &
+# define SCAN_QUOTED_STOPS "\"'$&"
+# define SCAN_QUOTED_MASK 0x21E
+// Expansion pass: quotes and $
+# define SCAN_EXPAND_STOPS "\"'$"
+# define SCAN_EXPAND_MASK 0x21A
+// Heredoc lines: only $
+# define SCAN_DOLLAR_STOPS "$"
+# define SCAN_DOLLAR_MASK 0x202
+
+typedef size_t					(*t_scan_fn)(const char *s, const char *stops);
+
+// Lexer state, the current token is input[start, pos)
+typedef struct s_lex
+{
+	char			*input;
+	int				start;
+	int				pos;
+	t_token_type	type;
+	int				quoted; // a quote was seen, has to be removed
+	int				expands; // $ or & was seen, expansion removes quotes
+}	t_lex;
 
 // Command table structs
 typedef struct s_redir
@@ -62,6 +143,10 @@ typedef struct s_redir
 typedef struct s_cmd
 {
 	char			**cmd_av;
+	int				cmd_ac; // arguments in cmd_av, without the NULL
+	int				av_cap; // pointers cmd_av has room for
+	char			**assigns; // VAR=value words before the command
+	int				assign_count; // words in assigns, only for its env
 	t_redir			*redirections;
 	char			*heredoc_filename; // Temporary file for heredoc input
 	struct s_cmd	*next_cmd;		//to be used if there is pipe
@@ -74,104 +159,221 @@ typedef struct s_cmd_table
 	t_cmd	*list_of_cmds;
 }	t_cmd_table;
 
+// One variable of the shell's variable table. Every variable is exported,
+// there are no shell-only ones: those with a value go to the env
 typedef struct s_var
 {
-	char			*name;
-	char			*value;
-	int				equal_sign;
-	struct s_var	*next_var;
+	char	*entry;		// "NAME=value", "NAME" without value, NULL if unset
+	int		name_len;	// length of NAME at the start of entry
+	int		len;		// length of entry
+	int		size;		// bytes allocated for entry
+	int		env_pos;	// index in shell->env, -1 if not in it
+	int		equal_sign;	// 1 if the variable has a value
 }	t_var;
 
+// One command of the command hash, heap memory kept between commands
+typedef struct s_hashed
+{
+	char	*name;		// command name, NULL for an empty slot
+	char	*path;		// where it was found in PATH, NULL if nowhere
+	int		hits;		// times it was run through the hash
+	int		dir;		// index of its directory in shell->path_dirs
+	mode_t	mode;		// st_mode of path when it was found
+	int		stale;		// its directory changed, search it again
+}	t_hashed;
+
+// One node of the command index, a prefix trie (see cmd_trie.c)
+typedef struct s_trie_node
+{
+	int		child;		// first child, -1 if none
+	int		next;		// next sibling (in order of c), -1 if none
+	char	c;			// character the node adds to the prefix
+	char	end;		// 1 if the prefix up to here is a command name
+}	t_trie_node;
+
+// Names of the builtins and of the executables in PATH, for completion
+typedef struct s_cmd_index
+{
+	t_trie_node	*nodes;		// nodes[0] is the root, the empty prefix
+	int			count;		// Nodes used
+	int			cap;		// Nodes allocated
+	char		*path;		// PATH the index was built for
+	char		**dirs;		// Its directories
+	t_stat		*stats;		// Their status at that time (mtime, inode)
+	int			dir_count;	// Number of dirs
+	int			next_dir;	// Directory the build reads next, dir_count
+							// once it is complete
+	DIR			*dirp;		// That directory while it is read
+}	t_cmd_index;
+
+// Matches of a completion, handed over to readline
+typedef struct s_match_list
+{
+	char	**list;					// list[0] is what replaces the word
+	int		count;					// Matches after list[0]
+	char	word[NAME_MAX + 1];		// Name being walked in the index
+}	t_match_list;
+
+// What a command started with posix_spawn() gets instead of a fork
+typedef struct s_spawn
+{
+	posix_spawn_file_actions_t	actions;	// pipe ends and redirections
+	posix_spawnattr_t			attr;		// signals set back to default
+	int							*fds;		// Redirection files, in the arena
+	int							fd_count;	// Files opened in fds
+	int							std[2];		// What stdin and stdout become
+	int							stage;		// Index in the pipeline, -1 alone
+	int							error;		// Error of the last try, 0 if none
+	int							status;		// Exit status when it failed for
+											// good, 0 when the caller forks
+}	t_spawn;
+
+// Output of a builtin, see out_buf.c
+typedef struct s_outbuf
+{
+	int		fd;					// Where it goes
+	int		failed;				// A write failed, the rest is dropped
+	size_t	len;				// Bytes waiting in buf
+	char	buf[OUT_BUF_SIZE];
+}	t_outbuf;
+
+// A builtin stage of a pipeline run on a thread, see pipeline_thread.c
+typedef struct s_stage
+{
+	pthread_t		thread;		// Running the builtin
+	t_shell			*shell;		// Read only while the thread runs
+	t_cmd			*cmd;		// The builtin
+	char			**env;		// Copy of the env pointers, for env
+	int				fd;			// Own copy of the stage's stdout
+	int				status;		// Exit status, set by the thread
+	int				started;	// The thread was created
+	int				done;		// Failed before it ran, status set
+}	t_stage;
+
+// Head of a request to the launcher, its strings follow: path, argv, env
+typedef struct s_launch_req
+{
+	size_t	size;	// Bytes of strings after the head
+	int		argc;	// Strings in argv
+	int		envc;	// Strings in env
+}	t_launch_req;
+
+// Answer of the launcher to a request
+typedef struct s_launch_reply
+{
+	pid_t	pid;	// Child of the shell running the command, -1 if none
+	int		error;	// errno of the failure, 0 if the command runs
+}	t_launch_reply;
+
+// Room for the descriptors sent along with a request (SCM_RIGHTS)
+typedef union u_launch_cmsg
+{
+	struct cmsghdr	align;
+	char			buf[CMSG_SPACE(sizeof(int) * LAUNCH_FDS)];
+}	t_launch_cmsg;
+
+// One argument of export, parsed in the arena
+typedef struct s_export
+{
+	char	*name;
+	char	*value;
+	int		equal_sign;
+}	t_export;
+
 // Shell state structure
 typedef struct s_shell
 {
-	char	**env;				// Our own copy of environment variables
-	int		env_capacity;		// Current capacity of env array
-	int		env_count;			// Current number of env variables
-	int		is_interactive;		// Interactive mode flag
-	char	*cwd;				// Current working directory
-	char	*oldpwd;			// Previous working directory (for cd -)
-	int		**pipe_array;		// Array of pipe file descriptors
-	int		*pipe_pids;			// Array of child process PIDs
-	int		children_forked;	// Number of children successfully forked
-	int		heredoc_counter;	// Counter for unique heredoc filenames
-	int		last_exit_status;	// Exit status of last command ($?)
-	t_arena	*arena;				// Memory arena for temporary allocations
-	t_var	*vars;				// Linked list of shell variables
+	t_var		*vars;				// Variable table, in order of creation
+	int			var_count;			// Entries used in vars, with holes
+	int			var_cap;			// Capacity of vars
+	int			var_live;			// Variables currently set
+	int			*var_index;			// Hash slots holding positions in vars
+	int			var_slots;			// Number of hash slots (power of two)
+	size_t		var_gen;			// Bumped by every change to the variables
+	char		**env;				// Environment for children, see shell_env()
+	int			env_count;			// Variables in env
+	int			env_cap;			// Pointers env has room for
+	size_t		env_gen;			// var_gen the env was built for
+	t_hashed	*hash;				// Command hash, see cmd_hash.c
+	int			hash_slots;			// Number of hash slots (power of two)
+	int			hash_count;			// Commands in the hash
+	char		*hash_path;			// PATH the hash was filled for
+	char		**path_dirs;		// Directories of that PATH
+	int			*path_fds;			// Their descriptors, -1 to use the path
+	int			path_dir_count;		// Number of path_dirs
+	int			path_watch;			// inotify descriptor, -1 if none
+	pid_t		pid;				// pid of the shell, not of a child
+	int			launcher;			// Socket to the launcher, -1 if none
+	pid_t		launcher_pid;		// The launcher process
+	int			*path_wds;			// Watch of each directory, -1 if none
+	int			hash_watched;		// Every directory of PATH is watched
+	t_cmd_index	cmd_index;			// Command names for tab completion
+	int			is_interactive;		// Interactive mode flag
+	char		*cwd;				// Current working directory
+	char		*oldpwd;			// Previous working directory (for cd -)
+	int			**pipe_array;		// Array of pipe file descriptors
+	int			pipe_count;			// Pipes in pipe_array
+	int			*pipe_pids;			// Array of child process PIDs
+	t_stage		*pipe_stages;		// Stages run on threads, by index
+	int			children_forked;	// Number of children successfully forked
+	int			heredoc_counter;	// Counter for unique heredoc filenames
+	int			last_exit_status;	// Exit status of last command ($?)
+	t_arena		*arena;				// Memory arena for temporary allocations
 }	t_shell;
 
 // Tokenization functions
-t_tokens		*tokenize_input(t_shell *shell, char *input);
-void			skip_whitespace(char *input, int *i);
-t_tokens		*process_single_token(t_shell *shell, char *input, int *i,
-					t_tokens **head);
-t_tokens		*create_token(t_arena *arena, char *word);
-t_token_type	get_token_type(char *str);
-void			add_to_end(t_tokens **head, t_tokens *new_node);
-int				has_quotes(char *str);
-
-// Parsing input for correct tokenization functions
-char			*extract_next_token(t_shell *shell, char *input, int *i);
-int				chop_up_input(t_shell *shell, char *input, int *i,
-					char **string);
-int				char_in_quotes(t_shell *shell, char **string,
-					char current_char, int *in_quotes);
-int				char_outside_quotes(t_shell *shell, char **string,
-					char current_char, int *in_quotes);
-int				see_quote_while_not_in_quotes(t_shell *shell, char **string,
-					char current_char, int *in_quotes);
-int				char_normal_outside_quotes(t_arena *arena, char **string,
-					char current_char);
-
-// Special token extraction functions
-int				extract_special_token(t_shell *shell, char **string,
-					char current);
-int				extract_pipe_token(t_shell *shell, char **string);
-int				extract_redirect_in_token(t_shell *shell, char **string);
-int				extract_redirect_out_token(t_shell *shell, char **string);
-
-// Quotes in string check and modify functions
-char			*check_for_quoted_string(t_arena *arena, char *str);
-int				check_for_unclosed_quote(char *str, size_t *i);
-int				remove_quotes_for_plain_string(t_arena *arena, char *str,
-					char **output, size_t *i);
-int				build_output(t_arena *arena, char **output, char c);
-int				ensure_output_not_null(t_arena *arena, char **output);
+t_token_list	*tokenize_input(t_shell *shell, char *input);
+int				lex_next_token(t_shell *shell, t_lex *lex);
+t_token_list	*new_token_list(t_arena *arena, size_t input_len);
+int				push_token(t_arena *arena, t_token_list *toks, t_lex *lex);
+
+// Byte scanning kernels
+size_t			scan_until(const char *s, t_scan_set set);
+size_t			scan_scalar(const char *s, const char *stops);
+size_t			scan_sse2(const char *s, const char *stops);
+size_t			scan_avx2(const char *s, const char *stops);
+int				scan_cpu_level(void);
+
+// Hashing (see var_index.c)
+unsigned int	str_hash(char *s, int len);
 
 // Parsing functions
-int				register_to_table(t_shell *shell, t_tokens *list_of_toks,
+int				register_to_table(t_shell *shell, t_token_list *toks,
 					t_cmd_table *table);
 t_cmd			*new_cmd_alloc(t_arena *arena);
 void			*err_msg_n_return_null(char *msg);
 int				err_msg_n_return_value(char *msg, int value);
 
 // Token checking functions
-int				check_current_token(t_shell *shell, t_tokens *token,
+int				check_current_token(t_shell *shell, t_token_list *toks,
 					t_cmd **current_cmd, t_cmd_table *table);
-int				check_token_word(t_shell *shell, t_tokens *token,
+int				check_token_word(t_shell *shell, t_token_list *toks,
 					t_cmd *current_cmd);
 int				expand_variable_name(t_shell *shell, char **original_string,
 					int in_redir);
 int				var_in_redir_outside_2xquotes(char *tok_value);
 int				add_argv(t_arena *arena, t_cmd *command, char *expansion);
-void			get_old_argv(char **old, char **new, size_t *i);
+int				is_assignment_word(char *word);
+void			split_prefix_assignments(t_cmd_table *table);
 
 // Variable name expansion
-int				go_thru_input(t_shell *shell, char *input, char **expand_text);
+int				go_thru_input(t_shell *shell, char *input,
+					t_ar_str *expand_text);
 int				dollar_sign_encounter(t_shell *shell, char *input, size_t *i,
-					char **text);
-int				other_character(t_arena *arena, char **expand_text,
+					t_ar_str *text);
+int				other_character(t_arena *arena, t_ar_str *expand_text,
 					char current_char, int *in_quote);
 int				build_var_name(t_shell *shell, char *input, size_t *i,
 					char **var_name);
-int				check_dollar_sign_position(char *input, size_t *i);
-int				transform_var_name(t_shell *shell, char **text, char *var_name);
+int				transform_var_name(t_shell *shell, t_ar_str *text,
+					char *var_name);
 
 //	Redirection functions
 int				is_redirection(t_token_type check);
-int				make_redir(t_shell *shell, t_tokens *curr_tok, t_cmd *curr_cmd);
+int				make_redir(t_shell *shell, t_token_list *toks,
+					t_cmd *curr_cmd);
 void			set_redir_type(t_token_type tok_type, t_token_type *redir_type);
-int				work_on_filename(t_shell *shell, t_tokens *tok_name,
+int				work_on_filename(t_shell *shell, t_token_list *toks,
 					char **name);
 
 #endif
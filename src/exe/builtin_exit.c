@@ -21,6 +21,7 @@
 static void	exit_shell(t_shell *shell, int exit_code)
 {
 	ft_printf("exit\n");
+	memstats_at_exit(shell);
 	rl_clear_history();
 	free_shell(shell);
 	exit(exit_code);
@@ -38,6 +39,7 @@ static void	exit_invalid_arg(t_shell *shell, char *arg)
 	ft_putstr_fd("minishell: exit: ", 2);
 	ft_putstr_fd(arg, 2);
 	ft_putstr_fd(": numeric argument required\n", 2);
+	memstats_at_exit(shell);
 	rl_clear_history();
 	free_shell(shell);
 	exit(2);
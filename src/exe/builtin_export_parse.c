@@ -12,12 +12,12 @@
 
 #include "minishell.h"
 
-/* Parse a single argument and save data to the arena t_var
+/* Parse a single argument and save data to the arena t_export
 (helper function of export_this_var())
 
 Return: 0 on success, -1 on errors
 */
-int	find_name_and_value(t_shell *shell, char *arg, t_var **var)
+int	find_name_and_value(t_shell *shell, char *arg, t_export **var)
 {
 	size_t	i;
 
@@ -40,20 +40,20 @@ Prevent further execution if name is not valid or empty
 
 Return: 0 on success, -1 on errors
 */
-int	this_is_name(t_shell *shell, char *arg, size_t *i, t_var **var)
+int	this_is_name(t_shell *shell, char *arg, size_t *i, t_export **var)
 {
 	while (arg[*i] && arg[*i] != '=')
 	{
 		if (!(ft_isalnum(arg[*i]) || arg[*i] == '_'))
 			return (err_msg_n_return_value("Not a valid identifier\n", -1));
-		(*var)->name = ar_add_char_to_str(shell->arena, (*var)->name, arg[*i]);
-		if (!(*var)->name)
-			return (err_msg_n_return_value("Error allocating memory for var "
-					"name in export\n", -1));
 		(*i)++;
 	}
-	if (!(*var)->name)
+	if (*i == 0)
 		return (err_msg_n_return_value("Not a valid identifier\n", -1));
+	(*var)->name = ar_substr(shell->arena, arg, 0, *i);
+	if (!(*var)->name)
+		return (err_msg_n_return_value("Error allocating memory for var "
+				"name in export\n", -1));
 	if (ft_strchr((*var)->name, '$') || ft_strchr((*var)->name, '&'))
 		if (expand_variable_name(shell, &(*var)->name, 0) == -1)
 			return (-1);
@@ -69,7 +69,7 @@ If there is no value assigned, variable value will be an empty string
 
 Return: 0 on success, -1 on errors
 */
-int	this_is_value(t_shell *shell, char *arg, size_t *i, t_var **var)
+int	this_is_value(t_shell *shell, char *arg, size_t *i, t_export **var)
 {
 	if (arg[*i] == '\0')
 	{
@@ -80,15 +80,11 @@ int	this_is_value(t_shell *shell, char *arg, size_t *i, t_var **var)
 	}
 	else
 	{
-		while (arg[*i])
-		{
-			(*var)->value = ar_add_char_to_str(shell->arena, (*var)->value,
-					arg[*i]);
-			if (!(*var)->value)
-				return (err_msg_n_return_value("Error in building var value to "
-						"export\n", -1));
-			(*i)++;
-		}
+		(*var)->value = ar_substr(shell->arena, arg, *i, ft_strlen(arg + *i));
+		if (!(*var)->value)
+			return (err_msg_n_return_value("Error in building var value to "
+					"export\n", -1));
+		*i += ft_strlen((*var)->value);
 		if (ft_strchr((*var)->value, '$') || ft_strchr((*var)->value, '&'))
 			if (expand_variable_name(shell, &(*var)->value, 0) == -1)
 				return (-1);
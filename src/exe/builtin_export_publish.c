@@ -12,89 +12,120 @@
 
 #include "minishell.h"
 
-/*Save the variable to the export list in the shell struct according to
-alphabetical order. Update if there is duplicate variable name with a value
-(helper function of export_this_var())
+/*Order two variables by name, like ft_strcmp() on the names alone
+(helper function of merge_halves())
+*/
+static int	var_name_cmp(t_var *a, t_var *b)
+{
+	int	len;
+	int	diff;
 
-Return values (0 or 1) are not checked in calling function
+	len = a->name_len;
+	if (b->name_len < len)
+		len = b->name_len;
+	diff = ft_strncmp(a->entry, b->entry, len);
+	if (diff)
+		return (diff);
+	return (a->name_len - b->name_len);
+}
+
+/*Merge the two sorted halves of list through tmp
+(helper function of sort_vars())
 */
-int	register_to_shell_vars(t_shell *shell, t_var *var)
+static void	merge_halves(t_var **list, t_var **tmp, int half, int count)
 {
-	t_var	*find_place;
-	t_var	*behind_this;
+	int	i;
+	int	j;
+	int	k;
 
-	if (!shell->vars)
-		shell->vars = var;
-	else
+	i = 0;
+	j = half;
+	k = 0;
+	while (i < half && j < count)
 	{
-		if (ft_strcmp(var->name, shell->vars->name) <= 0)
-			return (destined_to_be_first(shell, var));
+		if (var_name_cmp(list[i], list[j]) <= 0)
+			tmp[k++] = list[i++];
 		else
-		{
-			behind_this = shell->vars;
-			find_place = shell->vars->next_var;
-			while (find_place && ft_strcmp(find_place->name, var->name) < 0)
-			{
-				behind_this = find_place;
-				find_place = find_place->next_var;
-			}
-			if (find_place && ft_strcmp(find_place->name, var->name) == 0)
-				return (update_this_fella(var, find_place, behind_this));
-			var->next_var = find_place;
-			behind_this->next_var = var;
-		}
+			tmp[k++] = list[j++];
 	}
-	return (0);
+	while (i < half)
+		tmp[k++] = list[i++];
+	while (j < count)
+		tmp[k++] = list[j++];
+	ft_memcpy(list, tmp, sizeof(t_var *) * count);
 }
 
-/*Make variable the 1st node of the list. If it is a duplicate name, check if
-the new input has a value assigned in order to update the node.
-(helper function of register_to_shell_vars())
+/*Merge sort the variables by name, tmp has room for count pointers
+(helper function of plain_export())
+*/
+static void	sort_vars(t_var **list, t_var **tmp, int count)
+{
+	int	half;
 
-Return: 0 in normal cases, 1 when name is a duplicate and no value to update
+	if (count < 2)
+		return ;
+	half = count / 2;
+	sort_vars(list, tmp, half);
+	sort_vars(list + half, tmp, count - half);
+	merge_halves(list, tmp, half, count);
+}
+
+/*Print the variables the way "export" without arguments shows them,
+format based on if variable has a value assigned or not
+(helper function of plain_export())
+
+Return: 0 on success, 1 if the output could not be written
 */
-int	destined_to_be_first(t_shell *shell, t_var *var)
+static int	print_declares(t_var **list, int count, int fd)
 {
-	if (ft_strcmp(var->name, shell->vars->name) == 0)
+	t_outbuf	out;
+	int			i;
+
+	out_init(&out, fd);
+	i = 0;
+	while (i < count)
 	{
-		if (!var->equal_sign)
+		out_str(&out, "declare -x ");
+		out_mem(&out, list[i]->entry, list[i]->name_len);
+		if (list[i]->equal_sign)
 		{
-			free_1_var(&var);
-			var = shell->vars;
-			return (1);
+			out_str(&out, "=\"");
+			out_str(&out, list[i]->entry + list[i]->name_len + 1);
+			out_str(&out, "\"");
 		}
-		var->next_var = shell->vars->next_var;
-		free_1_var(&shell->vars);
-		shell->vars = var;
-		return (0);
-	}
-	else
-	{
-		var->next_var = shell->vars;
-		shell->vars = var;
-		return (0);
+		out_str(&out, "\n");
+		i++;
 	}
+	return (out_flush(&out));
 }
 
-/*Upon seeing a duplicate variable name, update that shell variable node if
-there is a new value assigned.
-(helper function of register_to_shell_vars())
+/*Print out the exported variables (other than "_") in alphabetical order.
+The sorted list is only made here, in the arena given, when it is asked
+for; a pipeline stage on a thread gives its own (see run_stage()).
 
-Return: 0 in normal cases, 1 when name is a duplicate and no value to update
+Return: 0 on success, 1 on errors
 */
-int	update_this_fella(t_var *var, t_var *find, t_var *behind)
+int	plain_export(t_shell *shell, t_arena *arena, int fd)
 {
-	if (!var->equal_sign)
-	{
-		free_1_var(&var);
-		var = find;
-		return (1);
-	}
-	else
+	t_var	**list;
+	t_var	**tmp;
+	t_var	*var;
+	int		count;
+	int		i;
+
+	list = ar_alloc(arena, sizeof(t_var *) * (shell->var_live + 1));
+	tmp = ar_alloc(arena, sizeof(t_var *) * (shell->var_live + 1));
+	if (!list || !tmp)
+		return (err_msg_n_return_value("Allocation failed for export list\n",
+				1));
+	count = 0;
+	i = 0;
+	while (i < shell->var_count)
 	{
-		behind->next_var = var;
-		var->next_var = find->next_var;
-		free_1_var(&find);
-		return (0);
+		var = &shell->vars[i++];
+		if (var->entry && !(var->name_len == 1 && var->entry[0] == '_'))
+			list[count++] = var;
 	}
+	sort_vars(list, tmp, count);
+	return (print_declares(list, count, fd));
 }
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_hash.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 19:02:44 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/08 19:02:46 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** put_hit_line - Print one line of the hash list, hits right aligned to 4
+*/
+static void	put_hit_line(int hits, char *path)
+{
+	int	width;
+	int	n;
+
+	width = 1;
+	n = hits;
+	while (n >= 10)
+	{
+		n /= 10;
+		width++;
+	}
+	while (width++ < 4)
+		ft_putchar_fd(' ', STDOUT_FILENO);
+	ft_putnbr_fd(hits, STDOUT_FILENO);
+	ft_putchar_fd('\t', STDOUT_FILENO);
+	ft_putendl_fd(path, STDOUT_FILENO);
+}
+
+/*
+** print_hash - List the commands of the command hash
+**
+** DESCRIPTION:
+**   Same layout as bash: hits and full path of every command that was
+**   found. Commands that were not found are not listed.
+*/
+static void	print_hash(t_shell *shell)
+{
+	int	header;
+	int	i;
+
+	header = 0;
+	i = 0;
+	while (i < shell->hash_slots)
+	{
+		if (shell->hash[i].name && shell->hash[i].path)
+		{
+			if (!header)
+				ft_putstr_fd("hits\tcommand\n", STDOUT_FILENO);
+			header = 1;
+			put_hit_line(shell->hash[i].hits, shell->hash[i].path);
+		}
+		i++;
+	}
+	if (!header)
+		ft_putstr_fd("hash: hash table empty\n", STDOUT_FILENO);
+}
+
+/*
+** hash_names - Search the named commands and put them in the hash
+**
+** PARAMETERS:
+**   shell - Shell state structure
+**   names - Command names, NULL terminated
+**
+** RETURN VALUE:
+**   Returns 0 if all were found, 1 otherwise
+*/
+static int	hash_names(t_shell *shell, char **names)
+{
+	t_stat	file_stat;
+	int		status;
+	int		i;
+
+	status = 0;
+	i = 0;
+	while (names[i])
+	{
+		if (!ft_strchr(names[i], '/')
+			&& !hashed_executable(shell, names[i], 0, &file_stat))
+		{
+			print_error("minishell: hash", names[i], "not found");
+			status = 1;
+		}
+		i++;
+	}
+	return (status);
+}
+
+/*
+** builtin_hash - Implementation of hash command
+**
+** DESCRIPTION:
+**   hash          lists the command hash
+**   hash -r       forgets every command
+**   hash NAME...  searches the commands in PATH and remembers them
+**   -r and names can be combined, -- ends the options.
+**
+** RETURN VALUE:
+**   Returns 0 on success, 1 if a name was not found, 2 on a bad option
+*/
+int	builtin_hash(t_shell *shell, t_cmd *cmd)
+{
+	int	cleared;
+	int	i;
+
+	cleared = 0;
+	i = 1;
+	while (cmd->cmd_av[i] && cmd->cmd_av[i][0] == '-' && cmd->cmd_av[i][1])
+	{
+		if (ft_strcmp(cmd->cmd_av[i++], "--") == 0)
+			break ;
+		if (ft_strcmp(cmd->cmd_av[i - 1], "-r") != 0)
+		{
+			print_error("minishell: hash", cmd->cmd_av[i - 1],
+				"invalid option");
+			ft_putstr_fd("hash: usage: hash [-r] [name ...]\n", 2);
+			return (2);
+		}
+		clear_cmd_hash(shell);
+		cleared = 1;
+	}
+	if (!cmd->cmd_av[i] && !cleared)
+		print_hash(shell);
+	return (hash_names(shell, cmd->cmd_av + i));
+}
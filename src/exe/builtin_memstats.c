@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_memstats.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/06 10:05:41 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/06 10:05:43 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** builtin_memstats - Implementation of memstats command
+**
+** DESCRIPTION:
+**   Prints the arena counters (chunks, bytes per phase, peaks) to stdout.
+**   The numbers include the memstats command line itself.
+**
+** RETURN VALUE:
+**   Returns 0 on success, 1 if the shell has no arena
+*/
+int	builtin_memstats(t_shell *shell)
+{
+	if (!shell || !shell->arena)
+		return (1);
+	ar_stats_print(shell->arena, STDOUT_FILENO);
+	return (0);
+}
+
+/*
+** memstats_at_exit - Dump the arena counters when the shell exits
+**
+** DESCRIPTION:
+**   If MINISHELL_MEMSTATS names a file, the final counters are appended to
+**   it, followed by an empty line. Nothing happens when it is unset or empty.
+**   Only the shell itself dumps them: exit run as a forked pipeline stage
+**   (exit | cat) leaves a copy of the counters that is not the shell's.
+**   Errors are ignored: the shell is exiting anyway.
+**
+** PARAMETERS:
+**   shell - Shell state structure, still intact
+*/
+void	memstats_at_exit(t_shell *shell)
+{
+	char	*path;
+	int		fd;
+
+	if (!shell || !shell->arena || shell->pid != getpid())
+		return ;
+	path = get_shell_env_value(shell, MEMSTATS_ENV);
+	if (!path || !path[0])
+		return ;
+	fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	if (fd == -1)
+		return ;
+	ar_stats_print(shell->arena, fd);
+	ft_putchar_fd('\n', fd);
+	close(fd);
+}
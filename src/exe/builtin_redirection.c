@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_redirection.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 14:06:27 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/11 14:06:29 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** restore_std_fds - Put stdin and stdout back from their saved copies
+**
+**   saved - Copies of stdin and stdout, -1 for one that was not saved;
+**           closed and set to -1
+*/
+static void	restore_std_fds(int *saved)
+{
+	int	fd;
+
+	fd = STDIN_FILENO;
+	while (fd <= STDOUT_FILENO)
+	{
+		if (saved[fd] >= 0)
+		{
+			dup2(saved[fd], fd);
+			close(saved[fd]);
+			saved[fd] = -1;
+		}
+		fd++;
+	}
+}
+
+/**
+** save_std_fds - Keep a copy of what the redirections of a command will
+** replace
+**
+**   Only stdin and stdout are redirected, each is saved at most once.
+**   The copies are close-on-exec.
+**
+**   cmd   - Command
+**   saved - Copies of stdin and stdout, -1 for one not redirected
+**
+**   Returns: 1 on success, 0 on failure (nothing kept)
+*/
+static int	save_std_fds(t_cmd *cmd, int *saved)
+{
+	t_redir	*redir;
+	int		fd;
+
+	saved[STDIN_FILENO] = -1;
+	saved[STDOUT_FILENO] = -1;
+	redir = cmd->redirections;
+	while (redir)
+	{
+		fd = STDIN_FILENO;
+		if (redir->tok_type == TOKEN_REDIRECT_OUT
+			|| redir->tok_type == TOKEN_APPEND)
+			fd = STDOUT_FILENO;
+		if (saved[fd] == -1)
+		{
+			saved[fd] = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+			if (saved[fd] == -1)
+				return (restore_std_fds(saved), 0);
+		}
+		redir = redir->next;
+	}
+	return (1);
+}
+
+/**
+** exe_builtin_in_shell - Run a builtin with its redirections and prefix
+** assignments without forking
+**
+**   stdin and stdout are saved, redirected for the builtin, then put
+**   back, also when a redirection fails. The assignments are applied to
+**   env and taken back the same way; the builtins that change the
+**   shell do not get them, as before. If stdin or stdout can not be
+**   saved (closed, or no descriptor left), the builtin is forked.
+**
+**   cmd   - Command, a builtin
+**   shell - Shell state structure
+**
+**   Returns: Exit status of the builtin, 1 if a redirection failed
+*/
+int	exe_builtin_in_shell(t_cmd *cmd, t_shell *shell)
+{
+	char	**saved_env;
+	int		saved[2];
+	int		code;
+
+	if (!save_std_fds(cmd, saved))
+		return (exe_builtin_with_fork(cmd, shell));
+	code = 1;
+	saved_env = NULL;
+	if (setup_redirections(cmd) == 0
+		&& (is_non_forkable_builtin(cmd->cmd_av[0])
+			|| push_env_overlay(shell, cmd, &saved_env)))
+	{
+		code = exe_builtin(cmd, shell);
+		pop_env_overlay(shell, saved_env);
+	}
+	restore_std_fds(saved);
+	return (code);
+}
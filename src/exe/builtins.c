@@ -20,36 +20,38 @@
 **
 ** PARAMETERS:
 **   cmd - Command structure with arguments
+**   fd  - Where to print
 **
 ** RETURN VALUE:
-**   Returns 0 on success
+**   Returns 0 on success, 1 if the output could not be written
 */
-int	builtin_echo(t_cmd *cmd)
+int	builtin_echo(t_cmd *cmd, int fd)
 {
-	int	i;
-	int	newline;
+	t_outbuf	out;
+	int			i;
+	int			newline;
 
 	if (!cmd || !cmd->cmd_av)
 		return (0);
 	newline = 1;
 	i = 1;
-	while (cmd->cmd_av[i] && cmd->cmd_av[i][0] == '-'
-		&& cmd->cmd_av[i][1] == 'n')
+	while (cmd->cmd_av[i] && !ft_strncmp(cmd->cmd_av[i], "-n", 2))
 	{
 		if (nl_flag_acceptable(cmd->cmd_av[i], &newline) == -1)
 			break ;
 		i++;
 	}
+	out_init(&out, fd);
 	while (cmd->cmd_av[i])
 	{
-		ft_printf("%s", cmd->cmd_av[i]);
+		out_str(&out, cmd->cmd_av[i]);
 		if (cmd->cmd_av[i + 1])
-			ft_printf(" ");
+			out_str(&out, " ");
 		i++;
 	}
 	if (newline)
-		ft_printf("\n");
-	return (0);
+		out_str(&out, "\n");
+	return (out_flush(&out));
 }
 
 /*Check if following -n, argument either ends or only contains 'n' character
@@ -78,12 +80,17 @@ int	nl_flag_acceptable(char *cmd_av, int *newline)
 ** DESCRIPTION:
 **   Prints current working directory.
 **
+** PARAMETERS:
+**   cmd - Command structure
+**   fd  - Where to print
+**
 ** RETURN VALUE:
 **   Returns 0 on success, 1 on error
 */
-int	builtin_pwd(t_cmd *cmd)
+int	builtin_pwd(t_cmd *cmd, int fd)
 {
-	char	*cwd;
+	t_outbuf	out;
+	char		*cwd;
 
 	(void)cmd;
 	cwd = getcwd(NULL, 0);
@@ -92,9 +99,11 @@ int	builtin_pwd(t_cmd *cmd)
 		perror("minishell: pwd");
 		return (1);
 	}
-	ft_printf("%s\n", cwd);
+	out_init(&out, fd);
+	out_str(&out, cwd);
+	out_str(&out, "\n");
 	free(cwd);
-	return (0);
+	return (out_flush(&out));
 }
 
 /*
@@ -103,20 +112,27 @@ int	builtin_pwd(t_cmd *cmd)
 ** DESCRIPTION:
 **   Prints all environment variables.
 **
+** PARAMETERS:
+**   env - Environment (see shell_env()), NULL prints nothing
+**   fd  - Where to print
+**
 ** RETURN VALUE:
-**   Returns 0 on success
+**   Returns 0 on success, 1 if the output could not be written
 */
-int	builtin_env(t_shell *shell)
+int	builtin_env(char **env, int fd)
 {
-	int	i;
+	t_outbuf	out;
+	int			i;
 
-	if (!shell || !shell->env)
+	if (!env)
 		return (0);
+	out_init(&out, fd);
 	i = 0;
-	while (shell->env[i])
+	while (env[i])
 	{
-		ft_printf("%s\n", shell->env[i]);
+		out_str(&out, env[i]);
+		out_str(&out, "\n");
 		i++;
 	}
-	return (0);
+	return (out_flush(&out));
 }
@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cmd_hash.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 18:05:21 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/08 18:05:23 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** hash_slot - Slot of a command name, or the empty slot it would go to
+**
+**   Open addressing with linear probing. Entries are never removed one
+**   by one (only all at once, see clear_cmd_hash()), so an empty slot
+**   ends the probe.
+**
+**   table - Slots to look in
+**   slots - Number of slots (power of two, never full)
+**   name  - Command name
+**
+**   Returns: Slot index
+*/
+static int	hash_slot(t_hashed *table, int slots, char *name)
+{
+	unsigned int	slot;
+	unsigned int	mask;
+
+	mask = slots - 1;
+	slot = str_hash(name, ft_strlen(name)) & mask;
+	while (table[slot].name && ft_strcmp(table[slot].name, name) != 0)
+		slot = (slot + 1) & mask;
+	return ((int)slot);
+}
+
+/**
+** reserve_hash - Make room for one more command
+**
+**   The table is kept at most half full. When it would get fuller it
+**   is replaced by one with twice the slots and the entries move over.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	reserve_hash(t_shell *shell)
+{
+	t_hashed	*bigger;
+	int			new_slots;
+	int			i;
+
+	if ((shell->hash_count + 1) * 2 <= shell->hash_slots)
+		return (1);
+	new_slots = CMD_HASH_MIN_SLOTS;
+	if (shell->hash_slots)
+		new_slots = shell->hash_slots * 2;
+	bigger = ft_calloc(new_slots, sizeof(t_hashed));
+	if (!bigger)
+		return (0);
+	i = 0;
+	while (i < shell->hash_slots)
+	{
+		if (shell->hash[i].name)
+			bigger[hash_slot(bigger, new_slots, shell->hash[i].name)]
+				= shell->hash[i];
+		i++;
+	}
+	free(shell->hash);
+	shell->hash = bigger;
+	shell->hash_slots = new_slots;
+	return (1);
+}
+
+/**
+** cmd_hash_find - Look a command up in the command hash
+**
+**   shell - Shell state structure
+**   name  - Command name
+**
+**   Returns: Slot in shell->hash, -1 if the command is not in it
+*/
+int	cmd_hash_find(t_shell *shell, char *name)
+{
+	int	slot;
+
+	if (!shell->hash_slots)
+		return (-1);
+	slot = hash_slot(shell->hash, shell->hash_slots, name);
+	if (!shell->hash[slot].name)
+		return (-1);
+	return (slot);
+}
+
+/**
+** cmd_hash_store - Remember where a command was found
+**
+**   A command that is in the hash already gets the new path, its hits
+**   are kept; a new one starts from a zeroed slot. Both strings are
+**   copied.
+**
+**   shell - Shell state structure
+**   name  - Command name
+**   path  - Full path of the command, NULL if it is nowhere in PATH
+**   dir   - Index of the PATH directory it was found in
+**
+**   Returns: Slot of the command, -1 on failure
+*/
+int	cmd_hash_store(t_shell *shell, char *name, char *path, int dir)
+{
+	char	*path_copy;
+	int		slot;
+
+	path_copy = NULL;
+	if (path)
+		path_copy = ft_strdup(path);
+	if (path && !path_copy)
+		return (-1);
+	slot = cmd_hash_find(shell, name);
+	if (slot == -1 && !reserve_hash(shell))
+		return (free(path_copy), -1);
+	if (slot == -1)
+	{
+		slot = hash_slot(shell->hash, shell->hash_slots, name);
+		shell->hash[slot].name = ft_strdup(name);
+		if (!shell->hash[slot].name)
+			return (free(path_copy), -1);
+		shell->hash_count++;
+	}
+	free(shell->hash[slot].path);
+	shell->hash[slot].path = path_copy;
+	shell->hash[slot].dir = dir;
+	shell->hash[slot].stale = 0;
+	return (slot);
+}
+
+/**
+** clear_cmd_hash - Forget every command (hash -r, PATH changed, exit)
+**
+**   The directories of the old PATH are closed as well.
+**
+**   shell - Shell state structure
+*/
+void	clear_cmd_hash(t_shell *shell)
+{
+	int	i;
+
+	i = 0;
+	while (i < shell->hash_slots)
+	{
+		free(shell->hash[i].name);
+		free(shell->hash[i].path);
+		i++;
+	}
+	free(shell->hash);
+	shell->hash = NULL;
+	shell->hash_slots = 0;
+	shell->hash_count = 0;
+	free(shell->hash_path);
+	shell->hash_path = NULL;
+	close_path_dirs(shell);
+}
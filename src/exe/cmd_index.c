@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cmd_index.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:40:51 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 10:40:53 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** index_is_current - Check if the command index is for this PATH and no
+** directory of it changed since
+**
+**   A file added to, removed from or renamed in a directory changes its
+**   mtime, so one stat() per directory is enough.
+**
+**   index    - Command index
+**   path_env - Value of PATH
+**
+**   Returns: 1 if it can be used, 0 if it has to be built again
+*/
+static int	index_is_current(t_cmd_index *index, char *path_env)
+{
+	t_stat	dir_stat;
+	int		i;
+
+	if (!index->path || ft_strcmp(index->path, path_env) != 0)
+		return (0);
+	i = 0;
+	while (i < index->dir_count)
+	{
+		if (index->dirs[i][0] != '/' || stat(index->dirs[i], &dir_stat) != 0)
+			ft_bzero(&dir_stat, sizeof(t_stat));
+		if (dir_stat.st_mtim.tv_sec != index->stats[i].st_mtim.tv_sec
+			|| dir_stat.st_mtim.tv_nsec != index->stats[i].st_mtim.tv_nsec)
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
+/**
+** load_index_dirs - Split PATH and stat each of its directories
+**
+**   Relative directories are not indexed (their content depends on the
+**   cwd), their status is left zeroed like that of a missing one.
+**
+**   index    - Command index, emptied before
+**   path_env - Value of PATH
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	load_index_dirs(t_cmd_index *index, char *path_env)
+{
+	int	i;
+
+	index->path = ft_strdup(path_env);
+	index->dirs = ft_split(path_env, ':');
+	if (!index->path || !index->dirs)
+		return (0);
+	while (index->dirs[index->dir_count])
+		index->dir_count++;
+	index->stats = malloc(sizeof(t_stat) * (index->dir_count + 1));
+	if (!index->stats)
+		return (0);
+	i = 0;
+	while (i < index->dir_count)
+	{
+		if (index->dirs[i][0] != '/' || stat(index->dirs[i], &index->stats[i]))
+			ft_bzero(&index->stats[i], sizeof(t_stat));
+		i++;
+	}
+	return (1);
+}
+
+/**
+** is_first_dir - Check if a directory of PATH was not seen earlier in it
+**
+**   /bin and /usr/bin are often the same directory, its names only need
+**   to be read once.
+**
+**   index - Command index
+**   i     - Index of the directory in index->dirs
+**
+**   Returns: 1 if it comes first, 0 if not
+*/
+static int	is_first_dir(t_cmd_index *index, int i)
+{
+	int	j;
+
+	j = 0;
+	while (j < i)
+	{
+		if (index->stats[j].st_ino == index->stats[i].st_ino
+			&& index->stats[j].st_dev == index->stats[i].st_dev)
+			return (0);
+		j++;
+	}
+	return (1);
+}
+
+/**
+** read_index_dir - Add the executables of the directory being read to
+** the index
+**
+**   Reads at most budget entries, so that a build can be spread over
+**   several calls. At the end of the directory it moves on to the next.
+**   Hidden names are left out.
+**
+**   index  - Command index, index->dirp open
+**   budget - Entries left to read in this call, decreased
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	read_index_dir(t_cmd_index *index, int *budget)
+{
+	struct dirent	*entry;
+	t_stat			st;
+
+	while (*budget > 0)
+	{
+		entry = readdir(index->dirp);
+		if (!entry)
+		{
+			closedir(index->dirp);
+			index->dirp = NULL;
+			index->next_dir++;
+			return (1);
+		}
+		(*budget)--;
+		if (entry->d_name[0] != '.'
+			&& fstatat(dirfd(index->dirp), entry->d_name, &st, 0) == 0
+			&& S_ISREG(st.st_mode) && (st.st_mode & (S_IXUSR | S_IXGRP
+					| S_IXOTH)) && !trie_insert(index, entry->d_name,
+				ft_strlen(entry->d_name)))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+** build_cmd_index - Make sure the command index matches PATH, build it
+** a slice at a time
+**
+**   The index is started again when PATH or the mtime of one of its
+**   directories changed, then at most budget directory entries are
+**   read. Missing directories and ones that came earlier in PATH are
+**   skipped. Tab completion asks for the rest at once, the idle hook of
+**   readline for a slice (see index_idle_hook()).
+**
+**   shell  - Shell state structure
+**   budget - Directory entries to read at most
+**
+**   Returns: 1 if the index is complete, 0 if not yet, -1 on failure
+*/
+int	build_cmd_index(t_shell *shell, int budget)
+{
+	t_cmd_index	*index;
+	char		*path_env;
+
+	index = &shell->cmd_index;
+	path_env = get_shell_env_value(shell, "PATH");
+	if (!path_env)
+		path_env = "";
+	if (!index_is_current(index, path_env))
+	{
+		clear_cmd_index(index);
+		if (!load_index_dirs(index, path_env) || !trie_reset(index))
+			return (clear_cmd_index(index), -1);
+	}
+	while (index->next_dir < index->dir_count && budget > 0)
+	{
+		if (!index->dirp && index->stats[index->next_dir].st_ino
+			&& is_first_dir(index, index->next_dir))
+			index->dirp = opendir(index->dirs[index->next_dir]);
+		if (!index->dirp)
+			index->next_dir++;
+		else if (!read_index_dir(index, &budget))
+			return (clear_cmd_index(index), -1);
+	}
+	return (index->next_dir == index->dir_count);
+}
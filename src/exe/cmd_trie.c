@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cmd_trie.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:12:05 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 10:12:07 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** The command index is a prefix trie kept in one array of nodes, linked
+** by index (first child, next sibling) so that growing the array does
+** not break any link. A node is 12 bytes; names that share a prefix
+** share its nodes. Siblings are sorted by character, so a walk of a
+** subtree gives its names in order.
+*/
+
+/**
+** trie_new_node - Take a node at the end of the array
+**
+**   The array doubles when it is full.
+**
+**   index - Command index
+**   c     - Character of the node
+**
+**   Returns: Index of the node, -1 on failure
+*/
+static int	trie_new_node(t_cmd_index *index, char c)
+{
+	t_trie_node	*bigger;
+	int			new_cap;
+
+	if (index->count == index->cap)
+	{
+		new_cap = CMD_INDEX_MIN_NODES;
+		if (index->cap)
+			new_cap = index->cap * 2;
+		bigger = malloc(sizeof(t_trie_node) * new_cap);
+		if (!bigger)
+			return (-1);
+		if (index->nodes)
+			ft_memcpy(bigger, index->nodes, sizeof(t_trie_node) * index->count);
+		free(index->nodes);
+		index->nodes = bigger;
+		index->cap = new_cap;
+	}
+	index->nodes[index->count].child = -1;
+	index->nodes[index->count].next = -1;
+	index->nodes[index->count].c = c;
+	index->nodes[index->count].end = 0;
+	return (index->count++);
+}
+
+/**
+** trie_child - Find the child of a node for a character
+**
+**   index  - Command index
+**   parent - Node to look under
+**   c      - Character of the child
+**   create - 1 to add the child when it is missing, in its sorted place
+**
+**   Returns: Index of the child, -1 if there is none (or on failure)
+*/
+int	trie_child(t_cmd_index *index, int parent, char c, int create)
+{
+	int	prev;
+	int	node;
+
+	prev = -1;
+	node = index->nodes[parent].child;
+	while (node != -1 && (unsigned char)index->nodes[node].c < (unsigned char)c)
+	{
+		prev = node;
+		node = index->nodes[node].next;
+	}
+	if (node != -1 && index->nodes[node].c == c)
+		return (node);
+	if (!create)
+		return (-1);
+	create = trie_new_node(index, c);
+	if (create == -1)
+		return (-1);
+	index->nodes[create].next = node;
+	if (prev == -1)
+		index->nodes[parent].child = create;
+	else
+		index->nodes[prev].next = create;
+	return (create);
+}
+
+/**
+** trie_insert - Add a name to the command index
+**
+**   index - Command index
+**   name  - Command name
+**   len   - Length of name
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	trie_insert(t_cmd_index *index, const char *name, int len)
+{
+	int	node;
+	int	i;
+
+	node = 0;
+	i = 0;
+	while (i < len)
+	{
+		node = trie_child(index, node, name[i], 1);
+		if (node == -1)
+			return (0);
+		i++;
+	}
+	index->nodes[node].end = 1;
+	return (1);
+}
+
+/**
+** trie_reset - Empty the command index, down to its root and the names
+** of the builtins
+**
+**   The nodes are kept for the next build.
+**
+**   index - Command index
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	trie_reset(t_cmd_index *index)
+{
+	char	*names;
+	int		len;
+
+	index->count = 0;
+	if (trie_new_node(index, '\0') != 0)
+		return (0);
+	names = BUILTIN_NAMES;
+	while (*names)
+	{
+		len = 0;
+		while (names[len] && names[len] != ' ')
+			len++;
+		if (!trie_insert(index, names, len))
+			return (0);
+		names += len;
+		if (*names == ' ')
+			names++;
+	}
+	return (1);
+}
+
+/**
+** clear_cmd_index - Forget the PATH the command index was built for
+**
+**   The names go too (count 0, not even a root), the array of nodes is
+**   kept for the next build: free_shell() frees it.
+**
+**   index - Command index
+*/
+void	clear_cmd_index(t_cmd_index *index)
+{
+	int	i;
+
+	i = 0;
+	while (index->dirs && index->dirs[i])
+		free(index->dirs[i++]);
+	free(index->dirs);
+	free(index->path);
+	free(index->stats);
+	if (index->dirp)
+		closedir(index->dirp);
+	index->dirs = NULL;
+	index->path = NULL;
+	index->stats = NULL;
+	index->dirp = NULL;
+	index->dir_count = 0;
+	index->next_dir = 0;
+	index->count = 0;
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   completion.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 11:58:32 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 11:58:34 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** completion_shell - Keep the shell for the readline completion hook
+**
+**   readline calls the hook without any user data, so the shell is
+**   remembered here once, by init_completion().
+**
+**   shell - Shell to remember, NULL to only get it
+**
+**   Returns: The shell remembered
+*/
+static t_shell	*completion_shell(t_shell *shell)
+{
+	static t_shell	*remembered;
+
+	if (shell)
+		remembered = shell;
+	return (remembered);
+}
+
+/**
+** is_command_position - Check if the word at start is a command name
+**
+**   It is when only blanks come before it, back to the start of the
+**   line or to a pipe.
+**
+**   start - Offset of the word in rl_line_buffer
+**
+**   Returns: 1 if it is, 0 if not
+*/
+static int	is_command_position(int start)
+{
+	int	i;
+
+	i = start - 1;
+	while (i >= 0 && (rl_line_buffer[i] == ' ' || rl_line_buffer[i] == '\t'))
+		i--;
+	return (i < 0 || rl_line_buffer[i] == '|');
+}
+
+/**
+** shell_completion - readline hook for tab completion
+**
+**   A command name is completed from the command index (builtins and
+**   PATH). Anything else, a word with a / or no command matching, is
+**   left to the filename completion of readline.
+**
+**   text  - Word being completed
+**   start - Its offset in rl_line_buffer
+**   end   - Offset of its end
+**
+**   Returns: Matches (see complete_command()), NULL for the default
+*/
+static char	**shell_completion(const char *text, int start, int end)
+{
+	t_shell	*shell;
+	char	**matches;
+
+	(void)end;
+	shell = completion_shell(NULL);
+	if (!is_command_position(start) || ft_strchr(text, '/')
+		|| build_cmd_index(shell, INT_MAX) != 1)
+		return (NULL);
+	matches = complete_command(&shell->cmd_index, text);
+	if (matches)
+		rl_attempted_completion_over = 1;
+	return (matches);
+}
+
+/**
+** index_idle_hook - Warm the command hash and index while readline waits
+**
+**   readline calls its event hook when no key came for a while (100 ms by
+**   default). Each call opens the PATH directories for the command hash
+**   if PATH changed, then reads one slice of the command index (see
+**   build_cmd_index()), so the first command and the first Tab find
+**   both ready. Until the index is complete readline is asked to call
+**   again sooner; a slice takes about a millisecond, typing does not
+**   wait on it. Once the index is complete (or can not be built) the
+**   hook takes itself out, so an idle prompt costs nothing: checking
+**   the index means a stat() per PATH directory. It is put back after
+**   each command line (see init_completion()). Only used in an
+**   interactive shell, it removes itself otherwise.
+**
+**   Returns: 0 (readline ignores it)
+*/
+int	index_idle_hook(void)
+{
+	t_shell	*shell;
+
+	shell = completion_shell(NULL);
+	if (!shell || !shell->is_interactive)
+	{
+		rl_event_hook = NULL;
+		return (0);
+	}
+	cmd_hash_current(shell);
+	if (build_cmd_index(shell, CMD_INDEX_SLICE) == 0)
+	{
+		rl_set_keyboard_input_timeout(CMD_INDEX_POLL_US);
+		return (0);
+	}
+	rl_set_keyboard_input_timeout(RL_POLL_US);
+	rl_event_hook = NULL;
+	return (0);
+}
+
+/**
+** init_completion - Hook command name completion into readline
+**
+**   Called at start and after every command line: a command may have
+**   changed PATH or one of its directories, so the idle hook goes back
+**   in to check the index again. It also goes back in after a heredoc,
+**   which uses the same hook (see restore_interactive_signals()).
+**
+**   shell - Shell state structure
+*/
+void	init_completion(t_shell *shell)
+{
+	completion_shell(shell);
+	rl_attempted_completion_function = shell_completion;
+	if (shell->is_interactive)
+		rl_event_hook = &index_idle_hook;
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   completion_matches.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 11:26:14 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 11:26:16 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** count_names - Count the names in a chain of siblings and below
+**
+**   index - Command index
+**   node  - First node of the chain, -1 for none
+**
+**   Returns: Number of names
+*/
+static int	count_names(t_cmd_index *index, int node)
+{
+	int	total;
+
+	total = 0;
+	while (node != -1)
+	{
+		total += index->nodes[node].end
+			+ count_names(index, index->nodes[node].child);
+		node = index->nodes[node].next;
+	}
+	return (total);
+}
+
+/**
+** collect_names - Copy the names of a chain of siblings and below into
+** the match list, in order
+**
+**   index - Command index
+**   node  - First node of the chain, -1 for none
+**   match - Match list, match->word holds the prefix of the chain
+**   depth - Length of that prefix
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	collect_names(t_cmd_index *index, int node, t_match_list *match,
+		int depth)
+{
+	while (node != -1)
+	{
+		match->word[depth] = index->nodes[node].c;
+		if (index->nodes[node].end)
+		{
+			match->list[++match->count] = ft_substr(match->word, 0, depth + 1);
+			if (!match->list[match->count])
+				return (0);
+		}
+		if (!collect_names(index, index->nodes[node].child, match, depth + 1))
+			return (0);
+		node = index->nodes[node].next;
+	}
+	return (1);
+}
+
+/**
+** common_prefix - What every match starts with
+**
+**   Below the node of the text, the prefix grows as long as the trie
+**   does not branch and no name ends.
+**
+**   index - Command index
+**   node  - Node of the text
+**   match - Match list, match->word starts with the text
+**   len   - Length of the text
+**
+**   Returns: The prefix (malloc), NULL on failure
+*/
+static char	*common_prefix(t_cmd_index *index, int node, t_match_list *match,
+		int len)
+{
+	int	child;
+
+	child = index->nodes[node].child;
+	while (!index->nodes[node].end && child != -1
+		&& index->nodes[child].next == -1)
+	{
+		match->word[len++] = index->nodes[child].c;
+		node = child;
+		child = index->nodes[node].child;
+	}
+	return (ft_substr(match->word, 0, len));
+}
+
+/**
+** fill_matches - Build the list readline wants for the names under a node
+**
+**   With one match, list[0] is that match. With more, list[0] is their
+**   common prefix and the matches follow. The list ends with NULL.
+**
+**   index - Command index
+**   node  - Node of the text
+**   match - Match list, match->list allocated, match->word holds text
+**   len   - Length of the text
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	fill_matches(t_cmd_index *index, int node, t_match_list *match,
+		int len)
+{
+	if (index->nodes[node].end)
+	{
+		match->list[++match->count] = ft_substr(match->word, 0, len);
+		if (!match->list[match->count])
+			return (0);
+	}
+	if (!collect_names(index, index->nodes[node].child, match, len))
+		return (0);
+	if (match->count == 1)
+	{
+		match->list[0] = match->list[1];
+		match->list[1] = NULL;
+		return (1);
+	}
+	match->list[0] = common_prefix(index, node, match, len);
+	return (match->list[0] != NULL);
+}
+
+/**
+** complete_command - Command names that start with text
+**
+**   The node of the text is found in one step per character, then only
+**   the names below it are visited: the cost does not depend on the
+**   size of PATH.
+**
+**   index - Command index (see build_cmd_index())
+**   text  - Word being completed
+**
+**   Returns: List for readline (malloc), NULL if nothing matches
+*/
+char	**complete_command(t_cmd_index *index, const char *text)
+{
+	t_match_list	match;
+	int				node;
+	int				len;
+
+	len = ft_strlen(text);
+	if (len > NAME_MAX)
+		return (NULL);
+	node = 0;
+	match.count = 0;
+	while (node != -1 && match.count < len)
+		node = trie_child(index, node, text[match.count++], 0);
+	if (node == -1)
+		return (NULL);
+	match.list = ft_calloc(index->nodes[node].end
+			+ count_names(index, index->nodes[node].child) + 2, sizeof(char *));
+	if (!match.list)
+		return (NULL);
+	ft_memcpy(match.word, text, len);
+	match.count = 0;
+	if (fill_matches(index, node, &match, len))
+		return (match.list);
+	while (match.count >= 0)
+		free(match.list[match.count--]);
+	return (free(match.list), NULL);
+}
@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   env_overlay.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 16:40:12 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/08 16:40:14 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** overlay_pos - Where the variable of an assignment sits in shell->env
+**
+**   A variable of the table is found through the hash index and its
+**   env_pos. One that is not in the table can still be in env when an
+**   earlier assignment of the same command appended it, so the entries
+**   appended from base on are checked too (A=1 A=2 cmd).
+**
+**   shell    - Shell state structure
+**   entry    - "NAME=value" of the assignment
+**   name_len - Length of NAME
+**   base     - Size of env before the first assignment was applied
+**
+**   Returns: Index in shell->env, -1 if the variable is not in it
+*/
+static int	overlay_pos(t_shell *shell, char *entry, int name_len, int base)
+{
+	int	slot;
+	int	pos;
+
+	slot = var_index_slot(shell, entry, name_len);
+	if (slot != -1 && shell->vars[shell->var_index[slot]].env_pos >= 0)
+		return (shell->vars[shell->var_index[slot]].env_pos);
+	pos = base;
+	while (pos < shell->env_count)
+	{
+		if (!ft_strncmp(shell->env[pos], entry, name_len + 1))
+			return (pos);
+		pos++;
+	}
+	return (-1);
+}
+
+/**
+** append_env - Add an entry at the end of shell->env
+**
+**   The array usually has room to spare (see shell_env.c). When it
+**   does not, it is replaced by one twice the size.
+**
+**   shell - Shell state structure
+**   entry - "NAME=value" to add
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	append_env(t_shell *shell, char *entry)
+{
+	char	**bigger;
+
+	if (shell->env_count + 2 > shell->env_cap)
+	{
+		bigger = malloc(sizeof(char *) * shell->env_cap * 2);
+		if (!bigger)
+			return (0);
+		ft_memcpy(bigger, shell->env, sizeof(char *) * shell->env_count);
+		free(shell->env);
+		shell->env = bigger;
+		shell->env_cap *= 2;
+	}
+	shell->env[shell->env_count++] = entry;
+	shell->env[shell->env_count] = NULL;
+	return (1);
+}
+
+/**
+** apply_env_overlay - Put the prefix assignments of a command in env
+**
+**   For VAR=value cmd: called in the child of cmd, which has its own
+**   copy of the env array, or by the shell around a command it runs
+**   itself (see push_env_overlay()). Each assignment replaces the
+**   pointer of its variable or is appended; the cost is per
+**   assignment, not per variable of the env.
+**   The entries are the words of the command, nothing is copied.
+**
+**   shell - Shell state structure
+**   cmd   - Command with its assignments in cmd->assigns
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	apply_env_overlay(t_shell *shell, t_cmd *cmd)
+{
+	int		base;
+	int		name_len;
+	int		pos;
+	int		i;
+
+	if (!cmd->assign_count)
+		return (1);
+	if (!shell_env(shell))
+		return (print_error("minishell", NULL, "Cannot allocate memory"), 0);
+	base = shell->env_count;
+	i = 0;
+	while (i < cmd->assign_count)
+	{
+		name_len = ft_strchr(cmd->assigns[i], '=') - cmd->assigns[i];
+		pos = overlay_pos(shell, cmd->assigns[i], name_len, base);
+		if (pos >= 0)
+			shell->env[pos] = cmd->assigns[i];
+		else if (!append_env(shell, cmd->assigns[i]))
+			return (print_error("minishell", NULL, "Cannot allocate memory"),
+				0);
+		i++;
+	}
+	return (1);
+}
+
+/**
+** push_env_overlay - Apply the prefix assignments of a command in the
+** shell, keeping what env was
+**
+**   For a command the shell starts or runs without forking. The saved
+**   pointers are in the arena; pop_env_overlay() puts them back. Only
+**   env changes: a PATH=value assignment is looked up by
+**   find_cmd_executable() itself.
+**
+**   shell - Shell state structure
+**   cmd   - Command with its assignments in cmd->assigns
+**   saved - Set to the saved env, NULL when there was nothing to apply
+**
+**   Returns: 1 on success, 0 on failure (env unchanged)
+*/
+int	push_env_overlay(t_shell *shell, t_cmd *cmd, char ***saved)
+{
+	size_t	size;
+
+	*saved = NULL;
+	if (!cmd->assign_count)
+		return (1);
+	if (!shell_env(shell))
+		return (print_error("minishell", NULL, "Cannot allocate memory"), 0);
+	size = sizeof(char *) * (shell->env_count + 1);
+	*saved = ar_alloc(shell->arena, size);
+	if (!*saved)
+		return (0);
+	ft_memcpy(*saved, shell->env, size);
+	if (apply_env_overlay(shell, cmd))
+		return (1);
+	pop_env_overlay(shell, *saved);
+	return (0);
+}
+
+/**
+** pop_env_overlay - Put env back the way push_env_overlay() found it
+**
+**   shell - Shell state structure
+**   saved - Saved env, NULL for none
+*/
+void	pop_env_overlay(t_shell *shell, char **saved)
+{
+	int	count;
+
+	if (!saved)
+		return ;
+	count = 0;
+	while (saved[count])
+		count++;
+	ft_memcpy(shell->env, saved, sizeof(char *) * (count + 1));
+	shell->env_count = count;
+}
@@ -20,6 +20,7 @@ int	dispatch_builtin(t_cmd *cmd, t_shell *shell);
 ** DESCRIPTION:
 **   Routes execution to single command or pipeline based on command count.
 **   Single commands execute directly, pipelines use pipe infrastructure.
+**   Arena use is attributed to the heredoc phase, then to the exec phase.
 **
 ** PARAMETERS:
 **   shell     - Shell state structure
@@ -32,11 +33,13 @@ int	exe_cmd(t_shell *shell, t_cmd_table *cmd_table)
 {
 	if (!cmd_table || !cmd_table->list_of_cmds || !shell)
 		return (0);
+	ar_set_phase(shell->arena, AR_HEREDOC);
 	if (handle_heredocs(shell, cmd_table) != 0)
 	{
 		cleanup_heredoc_files(cmd_table);
 		return (shell->last_exit_status);
 	}
+	ar_set_phase(shell->arena, AR_EXEC);
 	if (cmd_table->cmd_count > 1)
 		execute_pipeline(shell, cmd_table);
 	else
@@ -50,9 +53,9 @@ int	exe_cmd(t_shell *shell, t_cmd_table *cmd_table)
 ** dispatch_builtin - Dispatch builtin to correct execution context
 **
 ** DESCRIPTION:
-**   Decides whether to execute builtin in parent or child process.
-**   Parent-only: cd, export, unset, exit (modify shell state).
-**   Forkable: echo, pwd, env (safe to fork with redirections).
+**   Every builtin runs in the shell. With redirections or VAR=value
+**   prefixes it goes through exe_builtin_in_shell(), which saves and
+**   restores stdin/stdout instead of forking.
 **
 ** PARAMETERS:
 **   cmd   - Command structure
@@ -63,16 +66,11 @@ int	exe_cmd(t_shell *shell, t_cmd_table *cmd_table)
 */
 int	dispatch_builtin(t_cmd *cmd, t_shell *shell)
 {
-	char	*cmd_name;
-
 	if (!cmd || !cmd->cmd_av || !cmd->cmd_av[0])
 		return (0);
-	cmd_name = cmd->cmd_av[0];
-	if (is_non_forkable_builtin(cmd_name))
+	if (!cmd->redirections && !cmd->assign_count)
 		return (exe_builtin(cmd, shell));
-	if (!cmd->redirections)
-		return (exe_builtin(cmd, shell));
-	return (exe_builtin_with_fork(cmd, shell));
+	return (exe_builtin_in_shell(cmd, shell));
 }
 
 /*
@@ -94,7 +92,7 @@ int	exe_single_cmd(t_shell *shell, t_cmd *cmd)
 	if (!cmd || !shell)
 		return (0);
 	if (!cmd->cmd_av || !cmd->cmd_av[0])
-		return (exe_redirection_only(shell, cmd));
+		return (exe_redirection_only(cmd));
 	if (is_builtin(cmd->cmd_av[0]))
 		return (dispatch_builtin(cmd, shell));
 	return (exe_external_cmd(shell, cmd));
@@ -130,6 +128,10 @@ int	is_builtin(char *cmd)
 		return (1);
 	if (ft_strcmp(cmd, "exit") == 0)
 		return (1);
+	if (ft_strcmp(cmd, "memstats") == 0)
+		return (1);
+	if (ft_strcmp(cmd, "hash") == 0)
+		return (1);
 	return (0);
 }
 
@@ -156,16 +158,20 @@ int	exe_builtin(t_cmd *cmd, t_shell *shell)
 	if (ft_strcmp(cmd_name, "cd") == 0)
 		return (builtin_cd(shell, cmd));
 	else if (ft_strcmp(cmd_name, "echo") == 0)
-		return (builtin_echo(cmd));
+		return (builtin_echo(cmd, STDOUT_FILENO));
 	else if (ft_strcmp(cmd_name, "pwd") == 0)
-		return (builtin_pwd(cmd));
+		return (builtin_pwd(cmd, STDOUT_FILENO));
 	else if (ft_strcmp(cmd_name, "env") == 0)
-		return (builtin_env(shell));
+		return (builtin_env(shell_env(shell), STDOUT_FILENO));
 	else if (ft_strcmp(cmd_name, "exit") == 0)
 		return (builtin_exit(shell, cmd));
 	else if (ft_strcmp(cmd_name, "export") == 0)
 		return (builtin_export(shell, cmd));
 	else if (ft_strcmp(cmd_name, "unset") == 0)
 		return (builtin_unset(shell, cmd));
+	else if (ft_strcmp(cmd_name, "memstats") == 0)
+		return (builtin_memstats(shell));
+	else if (ft_strcmp(cmd_name, "hash") == 0)
+		return (builtin_hash(shell, cmd));
 	return (1);
 }
@@ -12,11 +12,29 @@
 
 #include "minishell.h"
 
+/*
+** exit_child - Leave a child that could not execute its command
+**
+** PARAMETERS:
+**   shell - Shell state structure, freed
+**   code  - Exit status
+*/
+static void	exit_child(t_shell *shell, int code)
+{
+	rl_clear_history();
+	free_shell(shell);
+	exit(code);
+}
+
 /*
 ** execute_child_process - Execute command in child process
 **
 ** DESCRIPTION:
-**   Child process: setup redirections and execute via execve.
+**   Child process: setup redirections, put the prefix assignments of the
+**   command in its env and execute via execve.
+**   If the file is gone or not executable any more, the path may come
+**   from a stale entry of the command hash (a chmod is not watched): the
+**   command is looked for again and checked like the first time.
 **   Never returns - exits with appropriate status.
 **
 ** PARAMETERS:
@@ -26,48 +44,55 @@
 */
 void	execute_child_process(t_shell *shell, t_cmd *cmd, char *path)
 {
+	t_stat	file_stat;
+	int		code;
+
 	reset_signals_for_child();
-	if (setup_redirections(cmd) != 0)
-	{
-		rl_clear_history();
-		free_shell(shell);
-		exit(1);
-	}
-	if (execve(path, cmd->cmd_av, shell->env) == -1)
+	if (setup_redirections(cmd) != 0 || !apply_env_overlay(shell, cmd))
+		exit_child(shell, 1);
+	execve(path, cmd->cmd_av, shell_env(shell));
+	if ((errno == EACCES || errno == ENOENT)
+		&& !ft_strchr(cmd->cmd_av[0], '/'))
 	{
-		perror("minishell: execve");
-		rl_clear_history();
-		free_shell(shell);
-		exit(126);
+		forget_hashed(shell, cmd->cmd_av[0]);
+		path = find_cmd_executable(shell, cmd, &file_stat);
+		code = validate_executable_path(cmd->cmd_av[0], path, &file_stat);
+		if (code != 0)
+			exit_child(shell, code);
+		execve(path, cmd->cmd_av, shell_env(shell));
 	}
+	perror("minishell: execve");
+	exit_child(shell, 126);
 }
 
 /*
 ** validate_executable_path - Validate if path is executable
 **
 ** DESCRIPTION:
-**   Checks if path exists, is not a directory, and has execute permissions.
+**   Checks if path is not a directory and has execute permissions, from
+**   the file status find_executable() got while looking for it.
 **
 ** PARAMETERS:
 **   cmd_name - Command name for error messages
 **   path     - Path to validate
+**   st       - File status of path
 **
 ** RETURN VALUE:
 **   Returns: 0 if valid, 127 if not found, 126 if directory/no permission
 */
-static int	validate_executable_path(char *cmd_name, char *path)
+int	validate_executable_path(char *cmd_name, char *path, t_stat *st)
 {
 	if (!path)
 	{
 		print_error("minishell", cmd_name, "command not found");
 		return (127);
 	}
-	if (is_directory(path))
+	if (S_ISDIR(st->st_mode))
 	{
 		print_error("minishell", cmd_name, "Is a directory");
 		return (126);
 	}
-	if (!is_executable(path))
+	if (!S_ISREG(st->st_mode) || !(st->st_mode & S_IXUSR))
 	{
 		print_error("minishell", cmd_name, "Permission denied");
 		return (126);
@@ -79,7 +104,10 @@ static int	validate_executable_path(char *cmd_name, char *path)
 ** exe_external_cmd - Execute external program
 **
 ** DESCRIPTION:
-**   Finds executable, forks, and executes external program.
+**   Finds executable and starts it with posix_spawn() (see spawn_cmd()).
+**   Forks and executes it in the child only when no child could be
+**   spawned. A forked stage of a pipeline is a child already: it
+**   executes the command itself.
 **
 ** PARAMETERS:
 **   shell - Shell state structure
@@ -90,21 +118,28 @@ static int	validate_executable_path(char *cmd_name, char *path)
 */
 int	exe_external_cmd(t_shell *shell, t_cmd *cmd)
 {
+	t_spawn	sp;
 	pid_t	pid;
 	char	*executable_path;
-	int		validation_status;
+	t_stat	file_stat;
 
-	executable_path = find_executable(shell, cmd->cmd_av[0]);
-	validation_status = validate_executable_path(cmd->cmd_av[0],
-			executable_path);
-	if (validation_status != 0)
-		return (validation_status);
-	pid = fork();
+	executable_path = find_cmd_executable(shell, cmd, &file_stat);
+	sp.status = validate_executable_path(cmd->cmd_av[0],
+			executable_path, &file_stat);
+	if (sp.status != 0)
+		return (sp.status);
+	if (!shell_env(shell))
+		return (print_error("minishell", NULL, "Cannot allocate memory"), 1);
+	if (shell->pid != getpid())
+		execute_child_process(shell, cmd, executable_path);
+	sp.stage = -1;
+	pid = spawn_cmd(shell, cmd, executable_path, &sp);
+	if (pid < 0 && sp.status)
+		return (sp.status);
 	if (pid < 0)
-	{
-		perror("minishell: fork");
-		return (1);
-	}
+		pid = fork();
+	if (pid < 0)
+		return (perror("minishell: fork"), 1);
 	if (pid == 0)
 		execute_child_process(shell, cmd, executable_path);
 	return (wait_and_get_status(pid));
@@ -115,7 +150,7 @@ int	exe_external_cmd(t_shell *shell, t_cmd *cmd)
 **
 ** DESCRIPTION:
 **   Forks and executes builtin in child process with redirections.
-**   Used for forkable builtins (echo, pwd, env) with redirections.
+**   Only used when exe_builtin_in_shell() can not save stdin/stdout.
 **
 ** PARAMETERS:
 **   cmd   - Command structure
@@ -127,7 +162,6 @@ int	exe_external_cmd(t_shell *shell, t_cmd *cmd)
 int	exe_builtin_with_fork(t_cmd *cmd, t_shell *shell)
 {
 	pid_t	pid;
-	int		code;
 
 	pid = fork();
 	if (pid < 0)
@@ -138,56 +172,9 @@ int	exe_builtin_with_fork(t_cmd *cmd, t_shell *shell)
 	if (pid == 0)
 	{
 		reset_signals_for_child();
-		if (setup_redirections(cmd) != 0)
-		{
-			rl_clear_history();
-			free_shell(shell);
-			exit(1);
-		}
-		code = exe_builtin(cmd, shell);
-		rl_clear_history();
-		free_shell(shell);
-		exit(code);
-	}
-	return (wait_and_get_status(pid));
-}
-
-/*
-** exe_redirection_only - Handle commands with only redirections
-**
-** DESCRIPTION:
-**   Processes redirections without executing a command (e.g., "< in > out").
-**   Fork required since redirections may fail and shouldn't affect parent.
-**
-** PARAMETERS:
-**   cmd - Command structure with redirections
-**
-** RETURN VALUE:
-**   Returns 0 on success, 1 on failure
-*/
-int	exe_redirection_only(t_shell *shell, t_cmd *cmd)
-{
-	pid_t	pid;
-
-	if (!cmd->redirections)
-		return (0);
-	pid = fork();
-	if (pid < 0)
-	{
-		perror("minishell: fork");
-		return (1);
-	}
-	if (pid == 0)
-	{
-		if (setup_redirections(cmd) != 0)
-		{
-			rl_clear_history();
-			free_shell(shell);
-			exit(1);
-		}
-		rl_clear_history();
-		free_shell(shell);
-		exit(0);
+		if (setup_redirections(cmd) != 0 || !apply_env_overlay(shell, cmd))
+			exit_child(shell, 1);
+		exit_child(shell, exe_builtin(cmd, shell));
 	}
 	return (wait_and_get_status(pid));
 }
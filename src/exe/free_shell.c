@@ -15,82 +15,30 @@
 /**
 ** free_shell - Free shell state structure and all its members
 **
-**   Properly deallocates all memory used by the shell state.
+**   Properly deallocates all memory used by the shell state. The inotify
+**   descriptor is closed first, so that a child shell leaving does not
+**   remove the watches of its parent (they share them).
 **
 **   shell - Shell state structure to free
 */
 void	free_shell(t_shell *shell)
 {
-	int	i;
-
 	if (!shell)
 		return ;
-	if (shell->env)
-	{
-		i = 0;
-		while (shell->env[i])
-			free(shell->env[i++]);
-		free(shell->env);
-	}
+	stop_launcher(shell);
+	free_var_store(shell);
+	if (shell->path_watch >= 0)
+		close(shell->path_watch);
+	shell->path_watch = -1;
+	clear_cmd_hash(shell);
+	clear_cmd_index(&shell->cmd_index);
+	free(shell->cmd_index.nodes);
 	free(shell->cwd);
 	free(shell->oldpwd);
 	free_arena(shell->arena);
-	free_list_of_vars(&shell->vars);
 	free(shell);
 }
 
-void	free_list_of_vars(t_var **var)
-{
-	t_var	*tmp;
-
-	if (var)
-	{
-		while (*var)
-		{
-			tmp = (*var)->next_var;
-			free_1_var(var);
-			*var = tmp;
-		}
-	}
-}
-
-void	free_1_var(t_var **var)
-{
-	if (*var)
-	{
-		if ((*var)->name)
-		{
-			free ((*var)->name);
-			(*var)->name = NULL;
-		}
-		if ((*var)->value)
-		{
-			free ((*var)->value);
-			(*var)->value = NULL;
-		}
-		free (*var);
-		*var = NULL;
-	}
-}
-
-/**
-** free_partial_env - Free partially allocated environment array
-**
-**   Helper function for cleanup during failed initialization.
-**
-**   shell - Shell state structure
-**   count - Number of successfully allocated entries
-*/
-void	free_partial_env(t_shell *shell, int count)
-{
-	int	i;
-
-	i = 0;
-	while (i < count)
-		free(shell->env[i++]);
-	free(shell->env);
-}
-
 /**
 ** cleanup_heredoc_files - Remove all temporary heredoc files
 **
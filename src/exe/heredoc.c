@@ -84,32 +84,31 @@ static int	handle_eof_error(t_shell *shell, char *delimiter)
 }
 
 /* process_heredoc_line - Expand variables if needed and write line to file
+** The expanded copy is scratch: it is rolled back out of the arena as soon
+** as it is written, so a huge heredoc only needs one line's worth of arena.
 ** Returns: 0 on success, 1 on failure
 */
 static int	process_heredoc_line(t_shell *shell, t_redir *redir, int fd,
 		char *line)
 {
-	char	*expanded_line;
+	char		*expanded_line;
+	t_ar_mark	mark;
+	int			status;
 
 	if (!line || !redir || !shell)
 		return (1);
+	mark = ar_mark(shell->arena);
 	if (redir->expand_heredoc)
 		expanded_line = expand_heredoc_line(shell, line);
 	else
-		expanded_line = ar_strdup(shell->arena, line);
-	if (!expanded_line)
-	{
-		if (line)
-			free(line);
-		return (1);
-	}
-	if (write_heredoc_line(fd, expanded_line) != 0)
-	{
-		if (line)
-			free(line);
-		return (1);
-	}
-	return (0);
+		expanded_line = line;
+	status = 0;
+	if (!expanded_line || write_heredoc_line(fd, expanded_line) != 0)
+		status = 1;
+	ar_rollback(shell->arena, mark);
+	if (status)
+		free(line);
+	return (status);
 }
 
 /* collect_heredoc_input - Read heredoc input until delimiter or EOF/interrupt
@@ -31,16 +31,16 @@ heredoc delimiter which contains $ or &
 */
 char	*special_heredoc_delimiter(t_arena *arena, char *delimiter)
 {
-	char	*result;
+	t_ar_str	result;
 
 	if (!delimiter)
 		return (NULL);
-	result = ar_alloc(arena, ft_strlen(delimiter) + 1);
-	if (!result)
+	ft_bzero(&result, sizeof(t_ar_str));
+	if (ar_str_reserve(arena, &result, ft_strlen(delimiter)) == -1)
 		return (NULL);
 	if (parse_special_delimiter(arena, delimiter, &result) == -1)
 		return (NULL);
-	return (result);
+	return (result.buf);
 }
 
 /* Other than most outer quotes (if present), add all characters from original
@@ -49,7 +49,7 @@ delimiter to the result string.
 
  Return: 0 on success, -1 on error
 */
-int	parse_special_delimiter(t_arena *arena, char *delimiter, char **result)
+int	parse_special_delimiter(t_arena *arena, char *delimiter, t_ar_str *result)
 {
 	char	quote;
 	int		in_quote;
@@ -68,8 +68,7 @@ int	parse_special_delimiter(t_arena *arena, char *delimiter, char **result)
 			in_quote = 0;
 		else
 		{
-			*result = ar_add_char_to_str(arena, *result, delimiter[i]);
-			if (!*result)
+			if (ar_str_putc(arena, result, delimiter[i]) == -1)
 				return (err_msg_n_return_value("Failed while building "
 						"heredoc eof\n", -1));
 		}
@@ -92,31 +91,28 @@ int	check_delimiter_match(char *line, char *delimiter)
 	return (0);
 }
 
-int	expand_dollar_sign(t_shell *shell, char *input, size_t *i, char **text)
+int	expand_dollar_sign(t_shell *shell, char *input, size_t *i,
+		t_ar_str *text)
 {
 	char	*var_name;
+	size_t	start;
 
-	var_name = NULL;
+	start = *i + 1;
 	while (ft_isalnum(input[*i + 1]) || input[*i + 1] == '_' || input[*i
 			+ 1] == '?')
 	{
-		var_name = ar_add_char_to_str(shell->arena, var_name, input[*i + 1]);
-		if (!var_name)
-			return (err_msg_n_return_value("Error building var name\n", -1));
 		(*i)++;
-		if (var_name[0] == '?' && input[*i + 1])
+		if (input[start] == '?' && input[*i + 1])
 			break ;
 	}
-	if (var_name)
+	if (*i + 1 == start)
 	{
-		if (transform_var_name(shell, text, var_name) == -1)
-			return (-1);
-	}
-	else
-	{
-		*text = ar_add_char_to_str(shell->arena, *text, '$');
-		if (!*text)
+		if (ar_str_putc(shell->arena, text, '$') == -1)
 			return (err_msg_n_return_value("Error adding $ to string\n", -1));
+		return (0);
 	}
-	return (0);
+	var_name = ar_substr(shell->arena, input, start, *i + 1 - start);
+	if (!var_name)
+		return (err_msg_n_return_value("Error building var name\n", -1));
+	return (transform_var_name(shell, text, var_name));
 }
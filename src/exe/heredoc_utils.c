@@ -30,6 +30,8 @@
 **   text    → text      (no change)
 **
 ** This is different from command-line parsing where quotes are removed.
+** The result is built in an arena string builder sized for the raw line,
+** text between $ signs is found with scan_until() and copied in one go.
 **
 **   shell - Shell state for variable expansion
 **   line  - Original line with potential variables
@@ -38,31 +40,30 @@
 */
 char	*expand_heredoc_line(t_shell *shell, char *line)
 {
-	char	*expanded;
-	size_t	i;
+	t_ar_str	expanded;
+	size_t		i;
+	size_t		run;
 
 	if (!shell || !line)
 		return (NULL);
-	expanded = ar_strdup(shell->arena, "");
-	if (!expanded)
+	ft_bzero(&expanded, sizeof(t_ar_str));
+	if (ar_str_reserve(shell->arena, &expanded, ft_strlen(line)) == -1)
 		return (NULL);
 	i = 0;
 	while (line[i])
 	{
+		run = scan_until(line + i, SCAN_DOLLAR);
+		if (ar_str_putn(shell->arena, &expanded, line + i, run) == -1)
+			return (NULL);
+		i += run;
 		if (line[i] == '$')
 		{
 			if (expand_dollar_sign(shell, line, &i, &expanded) == -1)
 				return (NULL);
+			i++;
 		}
-		else
-		{
-			expanded = ar_add_char_to_str(shell->arena, expanded, line[i]);
-			if (!expanded)
-				return (NULL);
-		}
-		i++;
 	}
-	return (expanded);
+	return (expanded.buf);
 }
 
 /**
@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   launcher.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 09:37:18 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/11 09:37:20 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** The launcher is a small process forked by init_shell(), before the
+** shell has an arena, history or readline state, when MINISHELL_LAUNCHER
+** is set. It reads requests (path, argv, env and the descriptors of the
+** command) from a socket and forks the command from its own small
+** address space. The fork uses CLONE_PARENT: the command is a child of
+** the shell, not of the launcher, so the shell waits for it with
+** waitpid() as for any other.
+*/
+
+#if defined(__linux__)
+
+# include <linux/sched.h>
+# include <sys/syscall.h>
+
+/**
+** exec_child - Set up the command started by the launcher and run it
+**
+**   The descriptors received are at 3 or above (the launcher keeps
+**   /dev/null on 0 to 2), so none is lost to the dup2() of another.
+**   If anything fails, errno goes to the launcher through err_fd.
+**
+**   vec    - Path, argv (NULL ended), env (NULL ended)
+**   argc   - Strings in argv
+**   fds    - stdin, stdout, stderr and cwd of the command
+**   err_fd - Write end of the error pipe, close-on-exec
+*/
+static void	exec_child(char **vec, int argc, int *fds, int err_fd)
+{
+	int	error;
+
+	signal(SIGINT, SIG_DFL);
+	signal(SIGQUIT, SIG_DFL);
+	signal(SIGPIPE, SIG_DFL);
+	if (dup2(fds[0], STDIN_FILENO) != -1 && dup2(fds[1], STDOUT_FILENO) != -1
+		&& dup2(fds[2], STDERR_FILENO) != -1 && fchdir(fds[3]) != -1)
+		execve(vec[0], vec + 1, vec + argc + 2);
+	error = errno;
+	write(err_fd, &error, sizeof(int));
+	_exit(127);
+}
+
+/**
+** launch_child - Fork the command of a request as a child of the shell
+**
+**   Waits until the command was executed, or failed to be: the error
+**   pipe is closed by execve(), or carries errno.
+**
+**   vec  - Path, argv, env (see recv_request())
+**   argc - Strings in argv
+**   fds  - Descriptors of the command
+**
+**   Returns: The answer for the shell
+*/
+static t_launch_reply	launch_child(char **vec, int argc, int *fds)
+{
+	t_launch_reply	reply;
+	int				err[2];
+
+	reply.pid = -1;
+	if (pipe(err) == -1)
+	{
+		reply.error = errno;
+		return (reply);
+	}
+	fcntl(err[0], F_SETFD, FD_CLOEXEC);
+	fcntl(err[1], F_SETFD, FD_CLOEXEC);
+	reply.pid = syscall(SYS_clone, CLONE_PARENT | SIGCHLD, 0, 0, 0, 0);
+	if (reply.pid == 0)
+		exec_child(vec, argc, fds, err[1]);
+	reply.error = errno;
+	close(err[1]);
+	if (reply.pid != -1
+		&& read(err[0], &reply.error, sizeof(int)) != sizeof(int))
+		reply.error = 0;
+	close(err[0]);
+	return (reply);
+}
+
+/**
+** launcher_main - Serve requests until the shell goes away
+**
+**   The launcher exits at the end of the socket, which comes at the
+**   latest when the shell exits.
+**
+**   sock - Launcher end of the socket
+*/
+static void	launcher_main(int sock)
+{
+	t_launch_reply	reply;
+	t_launch_req	head;
+	char			**vec;
+	int				fds[LAUNCH_FDS];
+	int				i;
+
+	i = open("/dev/null", O_RDWR);
+	if (i < 0 || dup2(i, 0) < 0 || dup2(i, 1) < 0 || dup2(i, 2) < 0)
+		exit(1);
+	if (i > 2)
+		close(i);
+	vec = recv_request(sock, &head, fds);
+	while (vec)
+	{
+		reply = launch_child(vec, head.argc, fds);
+		free(vec);
+		i = 0;
+		while (i < LAUNCH_FDS)
+			close(fds[i++]);
+		if (send(sock, &reply, sizeof(reply), MSG_NOSIGNAL) != sizeof(reply))
+			break ;
+		vec = recv_request(sock, &head, fds);
+	}
+	exit(0);
+}
+
+/**
+** start_launcher - Fork the launcher if MINISHELL_LAUNCHER is set
+**
+**   Called by init_shell() as early as possible, the launcher frees the
+**   little the shell has at that point. It ignores the keyboard
+**   signals, meant for the shell and its commands. Without a launcher,
+**   commands are started with posix_spawn() (see start_cmd()).
+**
+**   shell - Shell state structure, shell->launcher set on success
+*/
+void	start_launcher(t_shell *shell)
+{
+	int		sv[2];
+	pid_t	pid;
+
+	if (!get_shell_env_value(shell, LAUNCHER_ENV)
+		|| socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == -1)
+		return ;
+	pid = fork();
+	if (pid == 0)
+	{
+		close(sv[0]);
+		free_shell(shell);
+		signal(SIGINT, SIG_IGN);
+		signal(SIGQUIT, SIG_IGN);
+		launcher_main(sv[1]);
+	}
+	close(sv[1]);
+	if (pid == -1)
+	{
+		close(sv[0]);
+		return ;
+	}
+	shell->launcher = sv[0];
+	shell->launcher_pid = pid;
+}
+
+#else
+
+void	start_launcher(t_shell *shell)
+{
+	(void)shell;
+}
+
+#endif
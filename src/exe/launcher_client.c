@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   launcher_client.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 10:48:03 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/11 10:48:05 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** put_strings - Copy strings one after the other, each with its '\0'
+**
+**   dst   - Where they go, NULL to only measure them
+**   strs  - Strings
+**   count - Number of strings
+**
+**   Returns: Bytes they take
+*/
+static size_t	put_strings(char *dst, char **strs, int count)
+{
+	size_t	size;
+	size_t	len;
+	int		i;
+
+	size = 0;
+	i = 0;
+	while (i < count)
+	{
+		len = ft_strlen(strs[i]) + 1;
+		if (dst)
+			ft_memcpy(dst + size, strs[i], len);
+		size += len;
+		i++;
+	}
+	return (size);
+}
+
+/**
+** pack_request - Put a request for the launcher together in the arena
+**
+**   shell - Shell state structure, shell->env is sent
+**   path  - Executable path
+**   av    - Arguments of the command
+**   head  - Head of the request, filled
+**
+**   Returns: The head followed by its strings, NULL on failure
+*/
+static char	*pack_request(t_shell *shell, char *path, char **av,
+		t_launch_req *head)
+{
+	char	*req;
+	size_t	size;
+
+	head->argc = 0;
+	while (av[head->argc])
+		head->argc++;
+	head->envc = shell->env_count;
+	head->size = put_strings(NULL, &path, 1)
+		+ put_strings(NULL, av, head->argc)
+		+ put_strings(NULL, shell->env, head->envc);
+	req = ar_alloc(shell->arena, sizeof(t_launch_req) + head->size);
+	if (!req)
+		return (NULL);
+	ft_memcpy(req, head, sizeof(t_launch_req));
+	size = sizeof(t_launch_req);
+	size += put_strings(req + size, &path, 1);
+	size += put_strings(req + size, av, head->argc);
+	put_strings(req + size, shell->env, head->envc);
+	return (req);
+}
+
+/**
+** send_request - Send a request to the launcher with its descriptors
+**
+**   sock - Shell end of the socket
+**   req  - Request
+**   len  - Its length
+**   fds  - LAUNCH_FDS descriptors, the launcher gets copies of them
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	send_request(int sock, char *req, size_t len, int *fds)
+{
+	t_launch_cmsg	cmsg;
+	struct msghdr	msg;
+	struct iovec	iov;
+	ssize_t			sent;
+
+	iov.iov_base = req;
+	iov.iov_len = len;
+	ft_bzero(&msg, sizeof(msg));
+	ft_bzero(&cmsg, sizeof(cmsg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = cmsg.buf;
+	msg.msg_controllen = sizeof(cmsg.buf);
+	CMSG_FIRSTHDR(&msg)->cmsg_level = SOL_SOCKET;
+	CMSG_FIRSTHDR(&msg)->cmsg_type = SCM_RIGHTS;
+	CMSG_FIRSTHDR(&msg)->cmsg_len = CMSG_LEN(sizeof(int) * LAUNCH_FDS);
+	ft_memcpy(CMSG_DATA(CMSG_FIRSTHDR(&msg)), fds, sizeof(int) * LAUNCH_FDS);
+	sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+	while (sent > 0 && (size_t)sent < len)
+	{
+		req += sent;
+		len -= sent;
+		sent = send(sock, req, len, MSG_NOSIGNAL);
+	}
+	return (sent > 0);
+}
+
+/**
+** launch_cmd - Have the launcher start a command
+**
+**   The command gets the stdin and stdout of the spawn, the stderr and
+**   the working directory of the shell. A launcher that does not answer
+**   is stopped. When the command could not be executed, the launcher
+**   says so and the child it made is reaped here.
+**
+**   shell - Shell state structure (shell->launcher open)
+**   path  - Executable path
+**   av    - Arguments of the command
+**   sp    - Prepared spawn (see add_pipe_actions(), add_redir_actions())
+**
+**   Returns: pid of the command, -1 on failure
+*/
+pid_t	launch_cmd(t_shell *shell, char *path, char **av, t_spawn *sp)
+{
+	t_launch_req	head;
+	t_launch_reply	reply;
+	char			*req;
+	int				fds[LAUNCH_FDS];
+	int				sent;
+
+	fds[0] = sp->std[STDIN_FILENO];
+	fds[1] = sp->std[STDOUT_FILENO];
+	fds[2] = STDERR_FILENO;
+	fds[3] = -1;
+	req = pack_request(shell, path, av, &head);
+	if (req)
+		fds[3] = open(".", DIR_FD_FLAGS);
+	if (fds[3] < 0)
+		return (-1);
+	sent = send_request(shell->launcher, req, sizeof(head) + head.size, fds);
+	close(fds[3]);
+	if (!sent || !read_all(shell->launcher, &reply, sizeof(reply)))
+		return (stop_launcher(shell), -1);
+	if (reply.error && reply.pid > 0)
+		waitpid(reply.pid, NULL, 0);
+	if (reply.error)
+		return (-1);
+	return (reply.pid);
+}
+
+/**
+** stop_launcher - Close the socket to the launcher, which then exits
+**
+**   Only the shell waits for it, a forked child just closes its copy.
+**
+**   shell - Shell state structure
+*/
+void	stop_launcher(t_shell *shell)
+{
+	if (shell->launcher < 0)
+		return ;
+	close(shell->launcher);
+	shell->launcher = -1;
+	if (shell->pid == getpid())
+		waitpid(shell->launcher_pid, NULL, 0);
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   launcher_recv.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 10:14:52 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/11 10:14:54 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** read_all - Read exactly size bytes
+**
+**   fd   - Descriptor to read from
+**   buf  - Where the bytes go
+**   size - Bytes to read
+**
+**   Returns: 1 on success, 0 at the end of the file or on failure
+*/
+int	read_all(int fd, void *buf, size_t size)
+{
+	ssize_t	got;
+
+	while (size > 0)
+	{
+		got = read(fd, buf, size);
+		if (got == 0 || (got < 0 && errno != EINTR))
+			return (0);
+		if (got > 0)
+		{
+			buf = (char *)buf + got;
+			size -= got;
+		}
+	}
+	return (1);
+}
+
+/**
+** recv_head - Receive the head of a request and its descriptors
+**
+**   The descriptors come with the first bytes of the request, they are
+**   made close-on-exec: only the dup2() of exec_child() passes them on.
+**
+**   sock - Launcher end of the socket
+**   head - Head of the request, filled
+**   fds  - LAUNCH_FDS descriptors, filled
+**
+**   Returns: 1 on success, 0 at the end of the socket or on failure
+*/
+static int	recv_head(int sock, t_launch_req *head, int *fds)
+{
+	t_launch_cmsg	cmsg;
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*rights;
+	ssize_t			got;
+
+	iov.iov_base = head;
+	iov.iov_len = sizeof(t_launch_req);
+	ft_bzero(&msg, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = cmsg.buf;
+	msg.msg_controllen = sizeof(cmsg.buf);
+	got = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+	rights = NULL;
+	if (got > 0)
+		rights = CMSG_FIRSTHDR(&msg);
+	if (!rights || rights->cmsg_type != SCM_RIGHTS
+		|| rights->cmsg_len != CMSG_LEN(sizeof(int) * LAUNCH_FDS))
+		return (0);
+	ft_memcpy(fds, CMSG_DATA(rights), sizeof(int) * LAUNCH_FDS);
+	return (read_all(sock, (char *)head + got, sizeof(t_launch_req) - got));
+}
+
+/**
+** split_request - Point the vector of a request at its strings
+**
+**   vec  - Vector, the strings right after its argc + envc + 3 pointers
+**   head - Head of the request
+**
+**   Returns: 1 on success, 0 if the strings do not match the head
+*/
+static int	split_request(char **vec, t_launch_req *head)
+{
+	char	*strings;
+	size_t	pos;
+	int		i;
+
+	strings = (char *)(vec + head->argc + head->envc + 3);
+	if (head->size == 0 || strings[head->size - 1] != '\0')
+		return (0);
+	pos = 0;
+	i = 0;
+	while (i < head->argc + head->envc + 3)
+	{
+		vec[i] = NULL;
+		if (i != head->argc + 1 && i != head->argc + head->envc + 2)
+		{
+			if (pos >= head->size)
+				return (0);
+			vec[i] = strings + pos;
+			pos += ft_strlen(vec[i]) + 1;
+		}
+		i++;
+	}
+	return (pos == head->size);
+}
+
+/**
+** recv_request - Receive the next request of the shell
+**
+**   The vector and the strings it points to are one block: path, argv
+**   (NULL ended), then env (NULL ended).
+**
+**   sock - Launcher end of the socket
+**   head - Head of the request, filled
+**   fds  - stdin, stdout, stderr and cwd of the command, filled
+**
+**   Returns: The vector (malloc), NULL at the end of the socket or on
+**   failure
+*/
+char	**recv_request(int sock, t_launch_req *head, int *fds)
+{
+	char	**vec;
+	size_t	count;
+
+	if (!recv_head(sock, head, fds))
+		return (NULL);
+	count = head->argc + head->envc + 3;
+	vec = malloc(sizeof(char *) * count + head->size);
+	if (!vec || !read_all(sock, vec + count, head->size)
+		|| !split_request(vec, head))
+	{
+		free(vec);
+		return (NULL);
+	}
+	return (vec);
+}
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   out_buf.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/12 09:18:36 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/12 09:18:38 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** Output of the builtins that print (echo, pwd, env, export). A buffer
+** lives on the stack of the builtin and goes to the descriptor it was
+** given, so a builtin run on a thread of a pipeline (see
+** pipeline_thread.c) shares no state with the shell; it also turns the
+** many small writes of env or export into a few.
+*/
+
+/**
+** out_init - Start an empty buffer for a descriptor
+**
+**   out - Buffer
+**   fd  - Where its bytes go
+*/
+void	out_init(t_outbuf *out, int fd)
+{
+	out->fd = fd;
+	out->len = 0;
+	out->failed = 0;
+}
+
+/**
+** out_flush - Write what the buffer holds
+**
+**   A write that fails drops the rest of the output.
+**
+**   out - Buffer
+**
+**   Returns: 0 if everything was written, 1 if not
+*/
+int	out_flush(t_outbuf *out)
+{
+	ssize_t	done;
+	size_t	pos;
+
+	pos = 0;
+	while (!out->failed && pos < out->len)
+	{
+		done = write(out->fd, out->buf + pos, out->len - pos);
+		if (done < 0 && errno != EINTR)
+			out->failed = 1;
+		else if (done > 0)
+			pos += done;
+	}
+	out->len = 0;
+	return (out->failed);
+}
+
+/**
+** out_mem - Add bytes to the buffer, writing it when it is full
+**
+**   out - Buffer
+**   s   - Bytes
+**   len - How many
+*/
+void	out_mem(t_outbuf *out, const char *s, size_t len)
+{
+	size_t	part;
+
+	while (len > 0 && !out->failed)
+	{
+		part = OUT_BUF_SIZE - out->len;
+		if (part > len)
+			part = len;
+		ft_memcpy(out->buf + out->len, s, part);
+		out->len += part;
+		s += part;
+		len -= part;
+		if (out->len == OUT_BUF_SIZE)
+			out_flush(out);
+	}
+}
+
+/**
+** out_str - Add a string to the buffer
+**
+**   out - Buffer
+**   s   - String
+*/
+void	out_str(t_outbuf *out, const char *s)
+{
+	out_mem(out, s, ft_strlen(s));
+}
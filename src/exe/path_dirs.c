@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_dirs.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/09 11:14:37 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/09 11:14:39 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** open_path_dirs - Split PATH and open every absolute directory once
+**
+**   The directories of shell->hash_path are kept with a descriptor each
+**   until PATH changes (see clear_cmd_hash()), so a lookup probes a
+**   candidate with one fstatat() and no path building. A relative or
+**   missing directory gets -1 and is probed by its path instead: the
+**   first depends on the cwd, the second may show up later.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	open_path_dirs(t_shell *shell)
+{
+	int	i;
+
+	shell->path_dirs = ft_split(shell->hash_path, ':');
+	if (!shell->path_dirs)
+		return (0);
+	i = 0;
+	while (shell->path_dirs[i])
+		i++;
+	shell->path_fds = malloc(sizeof(int) * (i + 1));
+	if (!shell->path_fds)
+		return (close_path_dirs(shell), 0);
+	shell->path_dir_count = i;
+	i = 0;
+	while (i < shell->path_dir_count)
+	{
+		shell->path_fds[i] = -1;
+		if (shell->path_dirs[i][0] == '/')
+			shell->path_fds[i] = open(shell->path_dirs[i], DIR_FD_FLAGS);
+		i++;
+	}
+	return (1);
+}
+
+/**
+** close_path_dirs - Close and free what open_path_dirs() and
+** watch_path_dirs() made
+**
+**   shell - Shell state structure
+*/
+void	close_path_dirs(t_shell *shell)
+{
+	int	i;
+
+	unwatch_path_dirs(shell);
+	i = 0;
+	while (shell->path_dirs && shell->path_dirs[i])
+	{
+		if (i < shell->path_dir_count && shell->path_fds[i] >= 0)
+			close(shell->path_fds[i]);
+		free(shell->path_dirs[i++]);
+	}
+	free(shell->path_dirs);
+	free(shell->path_fds);
+	shell->path_dirs = NULL;
+	shell->path_fds = NULL;
+	shell->path_dir_count = 0;
+}
+
+/**
+** path_dir_gone - Check if a directory of PATH was removed since it was
+** opened
+**
+**   Our descriptor keeps a removed directory alive, so inotify does not
+**   report it (IN_DELETE_SELF only comes once the last reference is
+**   gone) and one made again under the same name would never be looked
+**   in. A removed directory has no links left.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 if one is gone, 0 if not
+*/
+int	path_dir_gone(t_shell *shell)
+{
+	t_stat	dir_stat;
+	int		i;
+
+	i = 0;
+	while (i < shell->path_dir_count)
+	{
+		if (shell->path_fds[i] >= 0 && fstat(shell->path_fds[i], &dir_stat) == 0
+			&& dir_stat.st_nlink == 0)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/**
+** probe_dir - Check for a regular file named cmd in one PATH directory
+**
+**   shell - Shell state structure
+**   i     - Index of the directory
+**   cmd   - Command name
+**   st    - Filled with the file status
+**
+**   Returns: 1 if there is one, 0 if not
+*/
+static int	probe_dir(t_shell *shell, int i, char *cmd, t_stat *st)
+{
+	t_ar_mark	mark;
+	char		*full_path;
+	int			found;
+
+	if (shell->path_fds[i] >= 0)
+		return (fstatat(shell->path_fds[i], cmd, st, 0) == 0
+			&& S_ISREG(st->st_mode));
+	mark = ar_mark(shell->arena);
+	full_path = build_path(shell, shell->path_dirs[i], cmd);
+	found = (full_path && stat(full_path, st) == 0 && S_ISREG(st->st_mode));
+	ar_rollback(shell->arena, mark);
+	return (found);
+}
+
+/**
+** probe_path_dirs - Search a command in the directories of PATH
+**
+**   Returns the first regular file found, even if it is not executable:
+**   the permission check is done later in exe_external_cmd, from st.
+**   Each directory costs one fstatat(), the full path is only built
+**   for the match.
+**
+**   shell - Shell state structure (open_path_dirs() done)
+**   cmd   - Command name
+**   st    - Filled with the file status of the match
+**   dir   - Set to the index of the directory of the match
+**
+**   Returns: Full path (arena), NULL if not found
+*/
+char	*probe_path_dirs(t_shell *shell, char *cmd, t_stat *st, int *dir)
+{
+	*dir = 0;
+	while (*dir < shell->path_dir_count)
+	{
+		if (probe_dir(shell, *dir, cmd, st))
+			return (build_path(shell, shell->path_dirs[*dir], cmd));
+		(*dir)++;
+	}
+	return (NULL);
+}
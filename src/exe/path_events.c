@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_events.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/09 15:03:41 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/09 15:03:44 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+#if defined(__linux__)
+
+# include <sys/inotify.h>
+
+/**
+** is_current_watch - Check if an event is for a watch of the current PATH
+**
+**   shell - Shell state structure
+**   wd    - Watch of the event
+**
+**   Returns: 1 if it is, 0 if not
+*/
+static int	is_current_watch(t_shell *shell, int wd)
+{
+	int	i;
+
+	i = 0;
+	while (shell->path_wds && i < shell->path_dir_count)
+	{
+		if (shell->path_wds[i] == wd)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/**
+** handle_path_event - Apply one inotify event to the command hash
+**
+**   A file that was created, removed or renamed marks the
+**   command of that name stale, nothing else. When a directory itself
+**   goes away, its watch was removed (IN_IGNORED, also when a child
+**   shell dropped it) or events were lost, the whole hash is dropped.
+**
+**   shell - Shell state structure
+**   event - The event
+**
+**   Returns: 1 to go on, 0 if the hash was dropped
+*/
+static int	handle_path_event(t_shell *shell, struct inotify_event *event)
+{
+	int	slot;
+
+	if (!(event->mask & IN_Q_OVERFLOW) && !is_current_watch(shell, event->wd))
+		return (1);
+	if (event->mask & (IN_Q_OVERFLOW | IN_IGNORED | IN_DELETE_SELF
+			| IN_MOVE_SELF | IN_UNMOUNT))
+	{
+		clear_cmd_hash(shell);
+		return (0);
+	}
+	if (!event->len)
+		return (1);
+	slot = cmd_hash_find(shell, event->name);
+	if (slot != -1)
+		shell->hash[slot].stale = 1;
+	return (1);
+}
+
+/**
+** drain_path_events - Read what happened in the PATH directories
+**
+**   Called before each command line. The descriptor is non-blocking, so
+**   with nothing pending this is one read() that returns EAGAIN.
+**
+**   shell - Shell state structure
+*/
+void	drain_path_events(t_shell *shell)
+{
+	char					buf[4096] __attribute__((aligned(8)));
+	struct inotify_event	*event;
+	ssize_t					len;
+	ssize_t					off;
+
+	if (shell->path_watch < 0)
+		return ;
+	len = read(shell->path_watch, buf, sizeof(buf));
+	while (len > 0)
+	{
+		off = 0;
+		while (off < len)
+		{
+			event = (struct inotify_event *)(buf + off);
+			if (!handle_path_event(shell, event))
+				return ;
+			off += sizeof(struct inotify_event) + event->len;
+		}
+		len = read(shell->path_watch, buf, sizeof(buf));
+	}
+}
+
+#else
+
+void	drain_path_events(t_shell *shell)
+{
+	(void)shell;
+}
+
+#endif
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_hash.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 18:31:02 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/08 18:31:04 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** cmd_hash_current - Make sure the command hash is for this PATH
+**
+**   When PATH is not the one the hash was filled for, every command is
+**   forgotten, the new PATH is remembered and its directories opened
+**   and watched.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 if the hash can be used, 0 if PATH is unset or on failure
+*/
+int	cmd_hash_current(t_shell *shell)
+{
+	char	*path_env;
+
+	path_env = get_shell_env_value(shell, "PATH");
+	if (!path_env)
+		return (0);
+	if (shell->hash_path && ft_strcmp(shell->hash_path, path_env) == 0)
+		return (1);
+	clear_cmd_hash(shell);
+	shell->hash_path = ft_strdup(path_env);
+	if (!shell->hash_path || !open_path_dirs(shell))
+		return (0);
+	watch_path_dirs(shell);
+	return (1);
+}
+
+/**
+** hash_hit - Check if a command of the hash can be used as it is
+**
+**   A command in a watched directory stays right until an event for its
+**   name marks it stale (see drain_path_events()), so it costs no
+**   syscall: its mode was kept when it was found. A chmod is not
+**   reported, so this only holds for a file that was executable: one
+**   that lost the bit fails to execute, and the command is then
+**   forgotten and looked for again (see forget_hashed()). Elsewhere one
+**   stat() checks that the file is still there. A command that was not
+**   found is looked for again when a directory of PATH was removed (it
+**   may be made again, see path_dir_gone()).
+**
+**   shell - Shell state structure
+**   slot  - Slot of the command in shell->hash
+**   st    - Filled with the file status of the path
+**
+**   Returns: 1 if it can be used, 0 if PATH has to be searched again
+*/
+static int	hash_hit(t_shell *shell, int slot, t_stat *st)
+{
+	t_hashed	*entry;
+
+	entry = &shell->hash[slot];
+	if (entry->stale)
+		return (0);
+	if (!entry->path)
+		return (!path_dir_gone(shell));
+	if (shell->path_wds && shell->path_wds[entry->dir] >= 0
+		&& (entry->mode & S_IXUSR))
+	{
+		st->st_mode = entry->mode;
+		return (1);
+	}
+	return (stat(entry->path, st) == 0 && S_ISREG(st->st_mode));
+}
+
+/**
+** hashed_executable - Find a command in PATH through the command hash
+**
+**   A command in the hash is not searched again (see hash_hit()).
+**   Otherwise PATH is searched (see probe_path_dirs()) and the result
+**   stored. Paths that depend on the cwd are not stored, and a command
+**   that was not found is only stored when every directory of PATH is
+**   watched, so it can not show up unnoticed. Before a miss is taken
+**   as final, removed directories are checked for (see path_dir_gone()).
+**   The hash is emptied when PATH changes and by hash -r.
+**
+**   shell     - Shell state structure
+**   cmd       - Command name, without a /
+**   count_hit - 1 when the command is going to run, 0 for hash NAME
+**   st        - Filled with the file status of the returned path
+**
+**   Returns: Full path, NULL if not found
+*/
+char	*hashed_executable(t_shell *shell, char *cmd, int count_hit, t_stat *st)
+{
+	char	*path;
+	int		slot;
+	int		dir;
+
+	if (!cmd_hash_current(shell))
+		return (NULL);
+	slot = cmd_hash_find(shell, cmd);
+	if (slot != -1 && hash_hit(shell, slot, st))
+	{
+		shell->hash[slot].hits += count_hit;
+		return (shell->hash[slot].path);
+	}
+	path = probe_path_dirs(shell, cmd, st, &dir);
+	if (!path && path_dir_gone(shell))
+		return (clear_cmd_hash(shell),
+			hashed_executable(shell, cmd, count_hit, st));
+	slot = -1;
+	if ((path && path[0] == '/') || (!path && shell->hash_watched))
+		slot = cmd_hash_store(shell, cmd, path, dir);
+	if (path && slot != -1)
+	{
+		shell->hash[slot].mode = st->st_mode;
+		shell->hash[slot].hits += count_hit;
+	}
+	return (path);
+}
+
+/**
+** forget_hashed - Make the next lookup of a command search PATH again
+**
+**   Used when what the hash gave could not be executed: the mode kept
+**   for a watched directory misses a chmod (see hash_hit()).
+**
+**   shell - Shell state structure
+**   name  - Command name
+*/
+void	forget_hashed(t_shell *shell, char *name)
+{
+	int	slot;
+
+	if (ft_strchr(name, '/'))
+		return ;
+	slot = cmd_hash_find(shell, name);
+	if (slot != -1)
+		shell->hash[slot].stale = 1;
+}
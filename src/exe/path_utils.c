@@ -12,146 +12,139 @@
 
 #include "minishell.h"
 
-static char	*search_in_path(t_shell *shell, char *cmd, char **path_dirs);
-static char	*handle_absolute_path(t_shell *shell, char *cmd);
+static char	*handle_absolute_path(t_shell *shell, char *cmd, t_stat *st);
 
 /*
 ** find_executable - Find executable path for command
 **
 ** DESCRIPTION:
-**   Searches for executable in PATH or returns absolute/relative path.
-**   Uses arena allocation for memory management.
+**   Returns absolute/relative path, or looks the command up in PATH
+**   through the command hash (see path_hash.c). The stat() result of the
+**   path is handed back in st, so it does not have to be probed again.
 **
 ** PARAMETERS:
-**   arena - Memory arena for allocations
-**   cmd - Command name
-**   env - Environment variables
+**   shell - Shell state structure
+**   cmd   - Command name
+**   st    - Filled with the file status of the returned path
 **
 ** RETURN VALUE:
 **   Returns path to executable or NULL if not found
 */
-char	*find_executable(t_shell *shell, char *cmd)
+char	*find_executable(t_shell *shell, char *cmd, t_stat *st)
 {
-	char	*path_env;
-	char	**path_dirs;
-
 	if (!cmd || !shell)
 		return (NULL);
 	if (ft_strchr(cmd, '/'))
-		return (handle_absolute_path(shell, cmd));
-	path_env = get_shell_env_value(shell, "PATH");
-	if (!path_env)
-		return (NULL);
-	path_dirs = ar_split(shell->arena, path_env, ':');
-	if (!path_dirs)
-		return (NULL);
-	return (search_in_path(shell, cmd, path_dirs));
+		return (handle_absolute_path(shell, cmd, st));
+	return (hashed_executable(shell, cmd, 1, st));
 }
 
 /*
-** handle_absolute_path - Handle absolute or relative path commands
+** prefix_path - PATH given by the prefix assignments of a command
 **
 ** PARAMETERS:
-**   shell - Shell state with arena
-**   cmd   - Command with path separator
+**   cmd - Command structure
 **
 ** RETURN VALUE:
-**   Returns duplicated path if file/directory exists, NULL otherwise
-**   (File type and permission checks are done later in exe_external_cmd)
+**   Returns the value of its last PATH=value assignment, NULL if none
 */
-static char	*handle_absolute_path(t_shell *shell, char *cmd)
+static char	*prefix_path(t_cmd *cmd)
 {
-	t_stat	file_stat;
+	char	*path;
+	int		i;
 
-	if (stat(cmd, &file_stat) == 0)
-		return (ar_strdup(shell->arena, cmd));
-	return (NULL);
+	path = NULL;
+	i = 0;
+	while (i < cmd->assign_count)
+	{
+		if (!ft_strncmp(cmd->assigns[i], "PATH=", 5))
+			path = cmd->assigns[i] + 5;
+		i++;
+	}
+	return (path);
 }
 
 /*
-** search_in_path - Search for command in PATH directories
+** search_path - Look a command up in a PATH that is not the shell's
 **
 ** DESCRIPTION:
-**   Searches for command file in PATH directories.
-**   Returns first match found, even if not executable.
-**   Permission check is done later in exe_external_cmd.
+**   Probes each directory by its full path, like probe_path_dirs() does
+**   for a directory it has no descriptor of; an empty one is the cwd.
+**   Nothing is stored in the command hash.
 **
 ** PARAMETERS:
-**   shell     - Shell state with arena
-**   cmd       - Command name
-**   path_dirs - Array of PATH directories
+**   shell - Shell state with arena
+**   path  - PATH value
+**   name  - Command name, without a /
+**   st    - Filled with the file status of the match
 **
 ** RETURN VALUE:
-**   Returns full path if found, NULL otherwise
+**   Returns full path of the first regular file found, NULL if none
 */
-static char	*search_in_path(t_shell *shell, char *cmd, char **path_dirs)
+static char	*search_path(t_shell *shell, char *path, char *name, t_stat *st)
 {
+	char	*dir;
 	char	*full_path;
-	int		i;
+	size_t	len;
 
-	i = 0;
-	while (path_dirs[i])
+	while (1)
 	{
-		full_path = build_path(shell, path_dirs[i], cmd);
-		if (full_path)
-		{
-			if (is_executable(full_path))
-				return (full_path);
-			if (is_regular_file(full_path))
-				return (full_path);
-		}
-		i++;
+		len = 0;
+		while (path[len] && path[len] != ':')
+			len++;
+		dir = ar_substr(shell->arena, path, 0, len);
+		full_path = build_path(shell, dir, name);
+		if (!full_path)
+			return (NULL);
+		if (stat(full_path, st) == 0 && S_ISREG(st->st_mode))
+			return (full_path);
+		if (!path[len])
+			return (NULL);
+		path += len + 1;
 	}
-	return (NULL);
 }
 
 /*
-** is_executable - Check if file is executable
+** find_cmd_executable - Find executable path for a command
 **
 ** DESCRIPTION:
-**   Checks if file exists and is executable.
+**   Like find_executable(), except when the command has a PATH=value
+**   prefix assignment: its name is then looked up in that PATH, as the
+**   command is going to get it, without the command hash.
 **
 ** PARAMETERS:
-**   path - Path to check
+**   shell - Shell state structure
+**   cmd   - Command structure
+**   st    - Filled with the file status of the returned path
 **
 ** RETURN VALUE:
-**   Returns 1 if executable, 0 otherwise
+**   Returns path to executable or NULL if not found
 */
-int	is_executable(char *path)
+char	*find_cmd_executable(t_shell *shell, t_cmd *cmd, t_stat *st)
 {
-	t_stat	file_stat;
+	char	*path;
 
-	if (!path)
-		return (0);
-	if (stat(path, &file_stat) != 0)
-		return (0);
-	if (S_ISREG(file_stat.st_mode) && (file_stat.st_mode & S_IXUSR))
-		return (1);
-	return (0);
+	path = prefix_path(cmd);
+	if (!path || !cmd->cmd_av[0] || ft_strchr(cmd->cmd_av[0], '/'))
+		return (find_executable(shell, cmd->cmd_av[0], st));
+	return (search_path(shell, path, cmd->cmd_av[0], st));
 }
 
 /*
-** is_regular_file - Check if path is a regular file
-**
-** DESCRIPTION:
-**   Checks if file exists and is a regular file (not directory, etc.)
-**   Does NOT check execute permission.
+** handle_absolute_path - Handle absolute or relative path commands
 **
 ** PARAMETERS:
-**   path - Path to check
+**   shell - Shell state with arena
+**   cmd   - Command with path separator
+**   st    - Filled with the file status of cmd
 **
 ** RETURN VALUE:
-**   Returns 1 if regular file exists, 0 otherwise
+**   Returns duplicated path if file/directory exists, NULL otherwise
+**   (File type and permission checks are done later in exe_external_cmd)
 */
-int	is_regular_file(char *path)
+static char	*handle_absolute_path(t_shell *shell, char *cmd, t_stat *st)
 {
-	t_stat	file_stat;
-
-	if (!path)
-		return (0);
-	if (stat(path, &file_stat) != 0)
-		return (0);
-	if (S_ISREG(file_stat.st_mode))
-		return (1);
-	return (0);
+	if (stat(cmd, st) == 0)
+		return (ar_strdup(shell->arena, cmd));
+	return (NULL);
 }
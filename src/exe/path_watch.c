@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_watch.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/09 14:22:18 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/09 14:22:20 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+#if defined(__linux__)
+
+# include <sys/inotify.h>
+
+/**
+** watch_path_dirs - Watch the directories of PATH for commands that come,
+** go or change
+**
+**   One watch per directory that has a descriptor in shell->path_fds.
+**   The inotify descriptor is made once and kept until the shell exits:
+**   closing one that still has watches waits for the kernel (several ms),
+**   dropping the watches does not (see unwatch_path_dirs()). Without
+**   inotify, or when a watch can not be added, that directory is simply
+**   not watched: its commands are checked with stat() (see hash_hit()).
+**   IN_ATTRIB is left out on purpose: asking for it makes the kernel walk
+**   every entry of the directory, about 1 ms for /usr/bin on each PATH
+**   change. A chmod is therefore not seen: a command that then fails to
+**   execute is forgotten and looked for again (see forget_hashed()).
+**   A forked child that looks a command up does not watch: its watches
+**   would die with it, and the close of the descriptor at its exit
+**   costs as much as above.
+**
+**   shell - Shell state structure (open_path_dirs() done)
+*/
+void	watch_path_dirs(t_shell *shell)
+{
+	int	i;
+
+	if (shell->pid != getpid())
+		return ;
+	shell->path_wds = malloc(sizeof(int) * (shell->path_dir_count + 1));
+	if (!shell->path_wds)
+		return ;
+	if (shell->path_watch < 0)
+		shell->path_watch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	shell->hash_watched = (shell->path_watch >= 0);
+	i = 0;
+	while (i < shell->path_dir_count)
+	{
+		shell->path_wds[i] = -1;
+		if (shell->path_watch >= 0 && shell->path_fds[i] >= 0)
+			shell->path_wds[i] = inotify_add_watch(shell->path_watch,
+					shell->path_dirs[i], IN_CREATE | IN_DELETE
+					| IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF
+					| IN_MOVE_SELF | IN_ONLYDIR);
+		if (shell->path_wds[i] < 0)
+			shell->hash_watched = 0;
+		i++;
+	}
+}
+
+/**
+** unwatch_path_dirs - Drop the watches of the PATH directories
+**
+**   The inotify descriptor stays open. Events still queued for the old
+**   watches are skipped by drain_path_events(): watch numbers are not
+**   reused by the kernel.
+**
+**   shell - Shell state structure
+*/
+void	unwatch_path_dirs(t_shell *shell)
+{
+	int	i;
+
+	i = 0;
+	while (shell->path_wds && i < shell->path_dir_count)
+	{
+		if (shell->path_watch >= 0 && shell->path_wds[i] >= 0)
+			inotify_rm_watch(shell->path_watch, shell->path_wds[i]);
+		i++;
+	}
+	free(shell->path_wds);
+	shell->path_wds = NULL;
+	shell->hash_watched = 0;
+}
+
+#else
+
+void	watch_path_dirs(t_shell *shell)
+{
+	(void)shell;
+}
+
+void	unwatch_path_dirs(t_shell *shell)
+{
+	free(shell->path_wds);
+	shell->path_wds = NULL;
+	shell->hash_watched = 0;
+}
+
+#endif
@@ -94,6 +94,8 @@ void	close_unused_pipes(t_shell *shell, int pipes_to_close)
 **
 ** WAITING STRATEGY:
 ** - Must wait for ALL children to prevent zombie processes
+** - Stages run on a thread are joined in their turn (pipeline_thread.c),
+**   stages that failed before they ran just give their status
 ** - Children may exit in any order, but we wait sequentially (0→N)
 ** - Only the LAST command's exit status matters (bash behavior)
 ** - waitpid() blocks if child still running,
@@ -123,11 +125,11 @@ void	wait_all_children(t_shell *shell, int cmd_count)
 	while (i < cmd_count)
 	{
 		if (shell->pipe_pids[i] > 0)
-		{
 			waitpid(shell->pipe_pids[i], &status, 0);
-			if (i == last_valid_cmd_index)
-				process_child_exit_status(shell, status);
-		}
+		else if (shell->pipe_stages[i].started || shell->pipe_stages[i].done)
+			status = join_thread_stage(shell, i);
+		if (i == last_valid_cmd_index)
+			process_child_exit_status(shell, status);
 		i++;
 	}
 	sigaction(SIGINT, &sa_old, NULL);
@@ -136,6 +138,9 @@ void	wait_all_children(t_shell *shell, int cmd_count)
 /**
 ** find_last_valid_cmd - Find index of last successfully forked command
 **
+** A stage that failed before it ran counts: its status is the one of
+** the pipeline, like the one of a child that could not execute.
+**
 **   shell     - Shell state with pipe PIDs
 **   cmd_count - Number of commands
 **
@@ -148,7 +153,8 @@ static int	find_last_valid_cmd(t_shell *shell, int cmd_count)
 	i = cmd_count - 1;
 	while (i >= 0)
 	{
-		if (shell->pipe_pids[i] > 0)
+		if (shell->pipe_pids[i] > 0 || shell->pipe_stages[i].started
+			|| shell->pipe_stages[i].done)
 			return (i);
 		i--;
 	}
@@ -38,8 +38,6 @@
 static int	init_pipeline(t_shell *shell, int cmd_count);
 static void	execute_pipeline_loop(t_shell *shell, t_cmd_table *cmd_table);
 static void	fork_all_children(t_shell *shell, t_cmd_table *cmd_table);
-static void	fork_pipeline_child(t_shell *shell, t_cmd *cmd, int i,
-				int cmd_count);
 
 /**
 ** execute_pipeline - Execute a pipeline of commands
@@ -81,6 +79,7 @@ void	execute_pipeline(t_shell *shell, t_cmd_table *cmd_table)
 ** - pipe_array: Array of (cmd_count-1) pipe pairs [read_fd, write_fd]
 **   Example: 3 commands need 2 pipes: cmd1|cmd2|cmd3
 ** - pipe_pids: Array of cmd_count PIDs for tracking child processes
+** - pipe_stages: Array of cmd_count stages, for those run on a thread
 **
 ** WHY ARRAYS: We need random access by index for pipe connections.
 ** Each command i connects to pipe[i-1] (input) and pipe[i] (output).
@@ -93,8 +92,12 @@ void	execute_pipeline(t_shell *shell, t_cmd_table *cmd_table)
 static int	init_pipeline(t_shell *shell, int cmd_count)
 {
 	shell->pipe_array = alloc_pipe_array(shell, cmd_count);
+	shell->pipe_count = cmd_count - 1;
 	shell->pipe_pids = ar_alloc(shell->arena, sizeof(int) * cmd_count);
-	if (!shell->pipe_pids || !shell->pipe_array)
+	shell->pipe_stages = ar_alloc(shell->arena, sizeof(t_stage) * cmd_count);
+	if (shell->pipe_stages)
+		ft_bzero(shell->pipe_stages, sizeof(t_stage) * cmd_count);
+	if (!shell->pipe_pids || !shell->pipe_array || !shell->pipe_stages)
 	{
 		write(STDERR_FILENO, "minishell: pipeline: memory allocation failed\n",
 			47);
@@ -110,6 +113,7 @@ static int	init_pipeline(t_shell *shell, int cmd_count)
 ** PIPELINE EXECUTION STRATEGY (Two-Phase Approach):
 ** Phase 1: Create ALL pipes before any forks
 ** Phase 2: Fork all children
+** The env block is built once before the forks, so no child builds its own.
 **
 ** WHY TWO PHASES: Creating pipes during forking caused race conditions.
 **
@@ -132,13 +136,18 @@ static void	execute_pipeline_loop(t_shell *shell, t_cmd_table *cmd_table)
 		}
 		i++;
 	}
+	shell_env(shell);
 	fork_all_children(shell, cmd_table);
 }
 
 /**
-** fork_all_children - Fork all child processes for pipeline
+** fork_all_children - Start all processes of the pipeline
 **
-** PHASE 2: Forks each command in sequence.
+** PHASE 2: Starts each command in sequence. External commands are
+** spawned (see spawn_stage()), the others are forked. A command that
+** could not be spawned is done: it is not forked again. Builtins that
+** only print are left for last, to run on threads once no process is
+** forked any more (see start_thread_stages()).
 ** Each child can safely dup2() from pre-existing pipes.
 **
 **   shell     - Shell state structure
@@ -147,28 +156,39 @@ static void	execute_pipeline_loop(t_shell *shell, t_cmd_table *cmd_table)
 static void	fork_all_children(t_shell *shell, t_cmd_table *cmd_table)
 {
 	t_cmd	*current_cmd;
-	int		cmd_count;
 	int		i;
 
 	current_cmd = cmd_table->list_of_cmds;
-	cmd_count = cmd_table->cmd_count;
 	i = 0;
-	while (i < cmd_count && current_cmd)
+	while (i < cmd_table->cmd_count && current_cmd)
 	{
-		fork_pipeline_child(shell, current_cmd, i, cmd_count);
+		if (!is_thread_stage(current_cmd))
+		{
+			shell->pipe_pids[i] = spawn_stage(shell, current_cmd, i);
+			if (shell->pipe_pids[i] >= 0)
+				shell->children_forked++;
+			else
+				fork_pipeline_child(shell, current_cmd, i,
+					cmd_table->cmd_count);
+		}
 		if (shell->pipe_pids[i] < 0)
 		{
-			close_unused_pipes(shell, cmd_count - 1);
+			close_unused_pipes(shell, cmd_table->cmd_count - 1);
 			return ;
 		}
 		current_cmd = current_cmd->next_cmd;
 		i++;
 	}
+	start_thread_stages(shell, cmd_table);
 }
 
 /**
 ** fork_pipeline_child - Fork and setup child process for pipeline command
 **
+** Used for builtins, redirection-only commands, commands that were not
+** found (the child reports it) and when no child could be spawned or
+** no thread could be started.
+**
 ** CHILD PROCESS SETUP:
 ** 1. Redirect stdin/stdout to appropriate pipes based on command position
 ** 2. Close all unused pipe file descriptors (prevent deadlocks)
@@ -185,8 +205,7 @@ static void	fork_all_children(t_shell *shell, t_cmd_table *cmd_table)
 **   i         - Command index in pipeline (0-based)
 **   cmd_count - Total number of commands
 */
-static void	fork_pipeline_child(t_shell *shell, t_cmd *cmd, int i,
-		int cmd_count)
+void	fork_pipeline_child(t_shell *shell, t_cmd *cmd, int i, int cmd_count)
 {
 	int	code;
 
@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipeline_thread.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/12 10:03:51 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/12 10:03:53 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** A stage of a pipeline that only prints (echo, pwd, env, export with no
+** argument, without redirections or assignments) runs on a thread of
+** the shell instead of a forked copy of it. The thread writes to its own
+** copy of the stage's stdout and closes it when done, which is the end
+** of file for the next stage. It shares nothing the shell changes while
+** the pipeline runs: its output buffer is on its stack (see out_buf.c),
+** env is a copy of the pointers made before it starts, export sorts in
+** an arena of its own. The variables are only read.
+** The threads are started once every other stage of the pipeline was
+** forked or spawned (see start_thread_stages()): no process is forked
+** while a thread runs, and no child gets a thread's copy of a pipe,
+** which would keep it open.
+*/
+
+/**
+** is_thread_stage - Check if a pipeline stage can run on a thread
+**
+**   cmd - Command of the stage
+**
+**   Returns: 1 if it can, 0 if it has to be forked or spawned
+*/
+int	is_thread_stage(t_cmd *cmd)
+{
+	char	*name;
+
+	if (!cmd->cmd_av || !cmd->cmd_av[0] || cmd->redirections
+		|| cmd->assign_count)
+		return (0);
+	name = cmd->cmd_av[0];
+	return (!ft_strcmp(name, "echo") || !ft_strcmp(name, "pwd")
+		|| !ft_strcmp(name, "env")
+		|| (!ft_strcmp(name, "export") && !cmd->cmd_av[1]));
+}
+
+/**
+** run_stage - Body of the thread of a builtin stage
+**
+**   arg - The stage (t_stage)
+**
+**   Returns: NULL, the exit status is left in the stage
+*/
+static void	*run_stage(void *arg)
+{
+	t_stage	*st;
+	t_arena	*arena;
+
+	st = arg;
+	if (!ft_strcmp(st->cmd->cmd_av[0], "echo"))
+		st->status = builtin_echo(st->cmd, st->fd);
+	else if (!ft_strcmp(st->cmd->cmd_av[0], "pwd"))
+		st->status = builtin_pwd(st->cmd, st->fd);
+	else if (!ft_strcmp(st->cmd->cmd_av[0], "env"))
+		st->status = builtin_env(st->env, st->fd);
+	else
+	{
+		st->status = 1;
+		arena = ar_init();
+		if (arena)
+			st->status = plain_export(st->shell, arena, st->fd);
+		free_arena(arena);
+	}
+	close(st->fd);
+	return (NULL);
+}
+
+/**
+** prepare_stage - Give a stage its stdout and, for env, its env
+**
+**   The copy of stdout is close-on-exec, a command started later does
+**   not get it.
+**
+**   shell - Shell state structure (shell_env() done)
+**   st    - Stage
+**   stage - Index of the stage in the pipeline
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	prepare_stage(t_shell *shell, t_stage *st, int stage)
+{
+	int	out;
+
+	st->env = NULL;
+	if (!ft_strcmp(st->cmd->cmd_av[0], "env") && shell->env)
+	{
+		st->env = ar_alloc(shell->arena,
+				sizeof(char *) * (shell->env_count + 1));
+		if (!st->env)
+			return (0);
+		ft_memcpy(st->env, shell->env,
+			sizeof(char *) * (shell->env_count + 1));
+	}
+	out = STDOUT_FILENO;
+	if (stage < shell->pipe_count)
+		out = shell->pipe_array[stage][1];
+	st->fd = fcntl(out, F_DUPFD_CLOEXEC, 0);
+	return (st->fd >= 0);
+}
+
+/**
+** start_thread_stage - Run a builtin stage of a pipeline on a thread
+**
+**   The thread blocks every signal, they stay with the main thread.
+**   On success the stage counts as started, with no pid (0).
+**
+**   shell - Shell state structure
+**   cmd   - Command of the stage, is_thread_stage()
+**   stage - Index of the stage in the pipeline
+**
+**   Returns: 1 if the thread runs it, 0 on failure (errno set)
+*/
+int	start_thread_stage(t_shell *shell, t_cmd *cmd, int stage)
+{
+	t_stage		*st;
+	sigset_t	all;
+	sigset_t	old;
+	int			error;
+
+	st = &shell->pipe_stages[stage];
+	st->shell = shell;
+	st->cmd = cmd;
+	if (!prepare_stage(shell, st, stage))
+		return (0);
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &old);
+	error = pthread_create(&st->thread, NULL, run_stage, st);
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
+	st->started = (error == 0);
+	if (!st->started)
+	{
+		close(st->fd);
+		errno = error;
+		return (0);
+	}
+	shell->pipe_pids[stage] = 0;
+	shell->children_forked++;
+	return (1);
+}
+
+/**
+** join_thread_stage - Wait for the thread of a builtin stage
+**
+**   A stage that is done (see spawn_stage()) has no thread, only its
+**   status.
+**
+**   shell - Shell state structure
+**   stage - Index of the stage, started by start_thread_stage() or done
+**
+**   Returns: Its exit status, in the form waitpid() gives it
+*/
+int	join_thread_stage(t_shell *shell, int stage)
+{
+	if (shell->pipe_stages[stage].started)
+		pthread_join(shell->pipe_stages[stage].thread, NULL);
+	shell->pipe_stages[stage].started = 0;
+	return (W_EXITCODE(shell->pipe_stages[stage].status, 0));
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipeline_threads.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/17 14:36:08 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/17 14:36:10 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** thread_failed - Give up on a stage no thread could be started for
+**
+**   Other threads already run, the stage can not be forked any more: it
+**   is done with status 1 (see join_thread_stage()), like a command
+**   fork() failed for.
+**
+**   shell - Shell state structure
+**   stage - Index of the stage in the pipeline
+*/
+static void	thread_failed(t_shell *shell, int stage)
+{
+	perror("minishell: thread");
+	shell->pipe_stages[stage].status = 1;
+	shell->pipe_stages[stage].done = 1;
+	shell->children_forked++;
+}
+
+/**
+** start_thread_stages - Start the builtin stages of a pipeline
+**
+**   Called once every other stage was forked or spawned (see
+**   fork_all_children()), so no process is forked while a thread runs.
+**   A stage whose thread can not be started is forked instead, as long
+**   as no thread runs yet.
+**
+**   shell     - Shell state structure
+**   cmd_table - Command table of the pipeline
+*/
+void	start_thread_stages(t_shell *shell, t_cmd_table *cmd_table)
+{
+	t_cmd	*cmd;
+	int		threads;
+	int		i;
+
+	cmd = cmd_table->list_of_cmds;
+	threads = 0;
+	i = 0;
+	while (i < cmd_table->cmd_count && cmd)
+	{
+		if (is_thread_stage(cmd) && start_thread_stage(shell, cmd, i))
+			threads++;
+		else if (is_thread_stage(cmd) && threads)
+			thread_failed(shell, i);
+		else if (is_thread_stage(cmd))
+			fork_pipeline_child(shell, cmd, i, cmd_table->cmd_count);
+		if (shell->pipe_pids[i] < 0)
+		{
+			close_unused_pipes(shell, cmd_table->cmd_count - 1);
+			return ;
+		}
+		cmd = cmd->next_cmd;
+		i++;
+	}
+}
@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   redirection_only.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 16:22:40 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/11 16:22:42 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** open_redir_fd - Open the file of one redirection
+**
+**   Same files and flags as setup_redirections(), with close-on-exec:
+**   a spawned command only gets them through the dup2 of its file
+**   actions. Nothing is printed on failure (see redir_error()).
+**
+**   redir - Redirection
+**   cmd   - Command it belongs to (heredoc file)
+**
+**   Returns: Descriptor, -1 on failure
+*/
+int	open_redir_fd(t_redir *redir, t_cmd *cmd)
+{
+	if (!redir->filename)
+		return (-1);
+	if (redir->tok_type == TOKEN_REDIRECT_OUT)
+		return (open(redir->filename, O_WRONLY | O_CREAT | O_TRUNC
+				| O_CLOEXEC, 0644));
+	if (redir->tok_type == TOKEN_APPEND)
+		return (open(redir->filename, O_WRONLY | O_CREAT | O_APPEND
+				| O_CLOEXEC, 0644));
+	if (redir->tok_type == TOKEN_REDIRECT_IN)
+		return (open(redir->filename, O_RDONLY | O_CLOEXEC));
+	if (redir->tok_type == TOKEN_HEREDOC && cmd->heredoc_filename)
+		return (open(cmd->heredoc_filename, O_RDONLY | O_CLOEXEC));
+	return (-1);
+}
+
+/**
+** redir_error - Report a redirection open_redir_fd() could not open
+**
+**   The messages are those of setup_redirections().
+**
+**   redir - Redirection, errno set by its open()
+**   cmd   - Command it belongs to
+*/
+void	redir_error(t_redir *redir, t_cmd *cmd)
+{
+	if (!redir->filename)
+		return ;
+	if (redir->tok_type == TOKEN_HEREDOC && !cmd->heredoc_filename)
+		print_error("minishell", "heredoc", "no temporary file");
+	else if (redir->tok_type == TOKEN_HEREDOC)
+		perror("minishell: heredoc");
+	else
+		perror(redir->filename);
+}
+
+/**
+** exe_redirection_only - Handle commands with only redirections
+**
+**   Processes redirections without executing a command (e.g., "< in > out").
+**   Nothing is redirected in the shell: each file is opened (created,
+**   truncated) and closed again, in order, up to the first that fails.
+**
+**   cmd - Command structure with redirections
+**
+**   Returns: 0 on success, 1 on failure
+*/
+int	exe_redirection_only(t_cmd *cmd)
+{
+	t_redir	*redir;
+	int		fd;
+
+	redir = cmd->redirections;
+	while (redir)
+	{
+		fd = open_redir_fd(redir, cmd);
+		if (fd < 0)
+		{
+			redir_error(redir, cmd);
+			return (1);
+		}
+		close(fd);
+		redir = redir->next;
+	}
+	return (0);
+}
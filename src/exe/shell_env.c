@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shell_env.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/07 15:31:47 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/07 15:31:49 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** reserve_env - Make room in shell->env for every variable that is set
+**
+**   The array is kept from one build to the next and only replaced by
+**   one of twice the size when the variables outgrow it. It only holds
+**   pointers: the "name=value" strings stay in the table, packing them
+**   next to the array would copy every string on each rebuild while
+**   execve() copies them again anyway.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	reserve_env(t_shell *shell)
+{
+	char	**bigger;
+	int		new_cap;
+
+	if (shell->env && shell->var_live + 1 <= shell->env_cap)
+		return (1);
+	new_cap = VAR_FIRST_CAP;
+	while (new_cap < shell->var_live + 1)
+		new_cap *= 2;
+	bigger = malloc(sizeof(char *) * new_cap);
+	if (!bigger)
+		return (0);
+	free(shell->env);
+	shell->env = bigger;
+	shell->env_cap = new_cap;
+	return (1);
+}
+
+/**
+** fill_env - Point env at every exported variable with a value
+**
+**   Each variable remembers where it sits in env (env_pos), so a
+**   child can put its own value in place (see apply_env_overlay()).
+**
+**   shell - Shell state structure
+*/
+static void	fill_env(t_shell *shell)
+{
+	t_var	*var;
+	int		i;
+	int		n;
+
+	i = 0;
+	n = 0;
+	while (i < shell->var_count)
+	{
+		var = &shell->vars[i++];
+		var->env_pos = -1;
+		if (var->entry && var->equal_sign)
+		{
+			var->env_pos = n;
+			shell->env[n++] = var->entry;
+		}
+	}
+	shell->env[n] = NULL;
+	shell->env_count = n;
+}
+
+/**
+** shell_env - Environment for execve() and env, built from the table
+**
+**   The array points to the entries of exported variables with a value,
+**   in table order. Every change to the table bumps var_gen; the array
+**   is only refilled when var_gen moved since it was built, so commands
+**   reuse it until a variable changes. It is built in the parent right
+**   before forking, children inherit it ready to use.
+**
+**   shell - Shell state structure
+**
+**   Returns: NULL terminated array, NULL on failure
+*/
+char	**shell_env(t_shell *shell)
+{
+	if (shell->env && shell->env_gen == shell->var_gen)
+		return (shell->env);
+	if (!reserve_env(shell))
+		return (NULL);
+	fill_env(shell);
+	shell->env_gen = shell->var_gen;
+	return (shell->env);
+}
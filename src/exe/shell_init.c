@@ -14,6 +14,7 @@
 
 static int	init_shell_env(t_shell *shell, char **env);
 static void	init_shell_paths(t_shell *shell);
+static int	init_shell_arena(t_shell *shell);
 
 /**
 ** init_shell - Initialize shell state structure
@@ -34,8 +35,12 @@ t_shell	*init_shell(int ac, char **av, char **env)
 	shell = ft_calloc(1, sizeof(t_shell));
 	if (!shell)
 		return (NULL);
+	shell->path_watch = -1;
+	shell->pid = getpid();
+	shell->launcher = -1;
 	if (!init_shell_env(shell, env))
 		return (free_shell(shell), NULL);
+	start_launcher(shell);
 	init_shell_paths(shell);
 	if (!shell->cwd || !shell->oldpwd)
 		return (free_shell(shell), NULL);
@@ -43,22 +48,18 @@ t_shell	*init_shell(int ac, char **av, char **env)
 	shell->is_interactive = isatty(STDIN_FILENO);
 	if (shell->is_interactive)
 		disable_echoctl();
-	shell->arena = ar_init();
-	if (!shell->arena)
-	{
-		print_error(NULL, NULL, "Failed to initialize memory arena");
-		free_shell(shell);
-		return (NULL);
-	}
+	if (!init_shell_arena(shell))
+		return (free_shell(shell), NULL);
 	(void)ac;
 	(void)av;
 	return (shell);
 }
 
 /**
-** init_shell_env - Initialize shell environment copy
+** init_shell_env - Initialize the variable table from the environment
 **
-**   Creates a dynamic copy of the environment variables with room for growth.
+**   Every inherited variable is copied to the table, exported. If a name
+**   shows up twice, the first one is kept.
 **
 **   shell - Shell state structure
 **   env   - Original environment variables
@@ -67,24 +68,51 @@ t_shell	*init_shell(int ac, char **av, char **env)
 */
 static int	init_shell_env(t_shell *shell, char **env)
 {
-	int	i;
+	char	*entry;
+	int		len;
+	int		i;
 
-	shell->env_count = 0;
-	while (env[shell->env_count])
-		shell->env_count++;
-	shell->env_capacity = shell->env_count + 32;
-	shell->env = ft_calloc(shell->env_capacity + 1, sizeof(char *));
-	if (!shell->env)
-		return (0);
 	i = 0;
-	while (i < shell->env_count)
+	while (env[i])
 	{
-		shell->env[i] = ft_strdup(env[i]);
-		if (!shell->env[i])
-			return (free_partial_env(shell, i), 0);
+		len = 0;
+		while (env[i][len] && env[i][len] != '=')
+			len++;
+		if (var_index_slot(shell, env[i], len) == -1)
+		{
+			entry = ft_strdup(env[i]);
+			if (!entry || var_store_add(shell, entry, len,
+					env[i][len] == '=') == -1)
+				return (free(entry), 0);
+		}
 		i++;
 	}
-	shell->env[i] = NULL;
+	return (1);
+}
+
+/**
+** init_shell_arena - Create the memory arena of the shell
+**
+**   If MINISHELL_TRIM_WINDOW is set, it is the number of recent commands
+**   whose chunk usage the arena keeps on reset (see ar_set_trim_window()).
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	init_shell_arena(t_shell *shell)
+{
+	char	*window;
+
+	shell->arena = ar_init();
+	if (!shell->arena)
+	{
+		print_error(NULL, NULL, "Failed to initialize memory arena");
+		return (0);
+	}
+	window = get_shell_env_value(shell, TRIM_WINDOW_ENV);
+	if (window)
+		ar_set_trim_window(shell->arena, ft_atoi(window));
 	return (1);
 }
 
@@ -113,31 +141,6 @@ static void	init_shell_paths(t_shell *shell)
 		shell->oldpwd = ft_strdup("");
 }
 
-/*
-** is_directory - Check if path is a directory
-**
-** DESCRIPTION:
-**   Checks if path exists and is a directory.
-**
-** PARAMETERS:
-**   path - Path to check
-**
-** RETURN VALUE:
-**   Returns 1 if path is a directory, 0 otherwise
-*/
-int	is_directory(char *path)
-{
-	t_stat	file_stat;
-
-	if (!path)
-		return (0);
-	if (stat(path, &file_stat) != 0)
-		return (0);
-	if (S_ISDIR(file_stat.st_mode))
-		return (1);
-	return (0);
-}
-
 /*
 ** is_non_forkable_builtin - Check if builtin must not fork
 **
@@ -160,5 +163,7 @@ int	is_non_forkable_builtin(char *cmd_name)
 		return (1);
 	if (ft_strcmp(cmd_name, "unset") == 0)
 		return (1);
+	if (ft_strcmp(cmd_name, "hash") == 0)
+		return (1);
 	return (0);
 }
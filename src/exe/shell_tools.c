@@ -15,7 +15,7 @@
 /**
 ** get_shell_env_value - Get environment variable value from shell
 **
-**   Searches shell's environment array for variable and returns its value.
+**   Looks the variable up in the variable table and returns its value.
 **
 **   shell - Shell state structure
 **   name  - Variable name to search for
@@ -25,27 +25,22 @@
 char	*get_shell_env_value(t_shell *shell, char *name)
 {
 	int	i;
-	int	name_len;
 
-	if (!shell || !shell->env || !name)
+	if (!shell || !name)
 		return (NULL);
-	name_len = ft_strlen(name);
-	i = 0;
-	while (shell->env[i])
-	{
-		if (ft_strncmp(shell->env[i], name, name_len) == 0
-			&& shell->env[i][name_len] == '=')
-			return (&shell->env[i][name_len + 1]);
-		i++;
-	}
-	return (NULL);
+	i = find_env_index(shell, name);
+	if (i < 0 || !shell->vars[i].equal_sign)
+		return (NULL);
+	return (shell->vars[i].entry + shell->vars[i].name_len + 1);
 }
 
 /**
 ** set_shell_env_value - Set environment variable in shell
 **
-**   Sets or updates an environment variable in the shell's environment.
-**   Automatically resizes the environment array if needed.
+**   Sets or updates a variable in the variable table and exports it.
+**   A new value overwrites the old one in place when it fits (see
+**   var_store_set_value()). A variable that had no value
+**   yet moves to the end, where it shows up in env from now on.
 **
 **   shell - Shell state structure
 **   name  - Variable name
@@ -60,28 +55,25 @@ int	set_shell_env_value(t_shell *shell, char *name, char *value)
 
 	if (!shell || !name || !value)
 		return (0);
+	i = find_env_index(shell, name);
+	if (i >= 0 && shell->vars[i].equal_sign)
+		return (var_store_set_value(shell, i, value));
+	if (i >= 0)
+		unset_shell_env_value(shell, name);
 	new_var = create_env_string(name, value);
 	if (!new_var)
 		return (0);
-	i = find_env_index(shell, name);
-	if (i >= 0)
-	{
-		free(shell->env[i]);
-		shell->env[i] = new_var;
-		return (1);
-	}
-	if (!resize_env_if_needed(shell))
+	if (var_store_add(shell, new_var, ft_strlen(name), 1) == -1)
 		return (free(new_var), 0);
-	shell->env[shell->env_count] = new_var;
-	shell->env[++shell->env_count] = NULL;
 	return (1);
 }
 
 /**
 ** unset_shell_env_value - Remove environment variable from shell
 **
-**   Removes an environment variable from the shell's environment.
-**	Shifts remaining variables to fill the gap and updates count.
+**   Removes a variable from the variable table. The entry becomes a hole
+**   and its hash slot is marked VAR_GONE, so nothing has to move; the
+**   holes are closed when the table runs full (see var_store.c).
 **
 **   shell - Shell state structure
 **   name  - Variable name to remove
@@ -90,24 +82,20 @@ int	set_shell_env_value(t_shell *shell, char *name, char *value)
 */
 int	unset_shell_env_value(t_shell *shell, char *name)
 {
-	int	i;
-	int	found_index;
+	int	slot;
+	int	pos;
 
 	if (!shell || !name)
 		return (-1);
-	found_index = find_env_index(shell, name);
-	if (found_index == -1)
-		return (-1);
-	else if (found_index == -2)
+	slot = var_index_slot(shell, name, ft_strlen(name));
+	if (slot == -1)
 		return (0);
-	free(shell->env[found_index]);
-	i = found_index;
-	while (i < shell->env_count - 1)
-	{
-		shell->env[i] = shell->env[i + 1];
-		i++;
-	}
-	shell->env[--shell->env_count] = NULL;
+	pos = shell->var_index[slot];
+	free(shell->vars[pos].entry);
+	shell->vars[pos].entry = NULL;
+	shell->var_index[slot] = VAR_GONE;
+	shell->var_live--;
+	shell->var_gen++;
 	return (1);
 }
 
@@ -40,64 +40,25 @@ char	*create_env_string(char *name, char *value)
 }
 
 /**
-** find_env_index - Find index of environment variable
+** find_env_index - Find the position of a variable in the variable table
 **
-**   Searches for environment variable and returns its index.
+**   Looks the variable up in the hash index (see var_index.c).
 **
 **   shell - Shell state structure
 **   name  - Variable name to find
 **
-**   Returns: Index if found, -1 if errors, -2 if not found
+**   Returns: Position in shell->vars if found, -1 if errors, -2 if not found
 */
 int	find_env_index(t_shell *shell, char *name)
 {
-	int	i;
-	int	name_len;
+	int	slot;
 
 	if (!shell || !name)
 		return (-1);
-	name_len = ft_strlen(name);
-	i = 0;
-	while (shell->env[i])
-	{
-		if (ft_strncmp(shell->env[i], name, name_len) == 0
-			&& shell->env[i][name_len] == '=')
-			return (i);
-		i++;
-	}
-	return (-2);
-}
-
-/**
-** resize_env_if_needed - Resize environment array if needed
-**
-**   Expands the environment array if it's getting full.
-**
-**   shell - Shell state structure
-**
-**   Returns: 1 on success, 0 on failure
-*/
-int	resize_env_if_needed(t_shell *shell)
-{
-	char	**new_env;
-	int		i;
-
-	if (shell->env_count + 1 < shell->env_capacity)
-		return (1);
-	shell->env_capacity *= 2;
-	new_env = malloc(sizeof(char *) * (shell->env_capacity + 1));
-	if (!new_env)
-		return (0);
-	i = 0;
-	while (i < shell->env_count)
-	{
-		new_env[i] = shell->env[i];
-		i++;
-	}
-	new_env[i] = NULL;
-	free(shell->env);
-	shell->env = new_env;
-	return (1);
+	slot = var_index_slot(shell, name, ft_strlen(name));
+	if (slot == -1)
+		return (-2);
+	return (shell->var_index[slot]);
 }
 
 /**
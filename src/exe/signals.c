@@ -41,12 +41,15 @@ int	disable_echoctl(void)
 **
 ** DESCRIPTION:
 **   Child processes should receive signals normally (not handled by shell).
-**   Called after fork() but before execve().
+**   SIGPIPE too: the shell ignores it, a command must not inherit that.
+**   Called after fork() but before execve() (see init_spawn() for the
+**   commands that are spawned).
 */
 void	reset_signals_for_child(void)
 {
 	signal(SIGINT, SIG_DFL);
 	signal(SIGQUIT, SIG_DFL);
+	signal(SIGPIPE, SIG_DFL);
 }
 
 /**
@@ -54,7 +57,8 @@ void	reset_signals_for_child(void)
 **
 ** DESCRIPTION:
 **   Restores normal interactive signal handling after heredoc completes.
-**   Clears the readline event hook and resets the signal flag.
+**   Puts the idle hook of the command index back in place of the one of
+**   the heredoc and resets the signal flag.
 **
 ** WHY NEEDED:
 **   Heredoc mode uses special signal handling. After heredoc completes
@@ -71,7 +75,7 @@ void	restore_interactive_signals(void)
 	sa.sa_handler = SIG_IGN;
 	sa.sa_flags = 0;
 	sigaction(SIGQUIT, &sa, NULL);
-	rl_event_hook = NULL;
+	rl_event_hook = &index_idle_hook;
 	g_signal = 0;
 }
 
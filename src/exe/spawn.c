@@ -0,0 +1,203 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 14:51:09 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 14:51:11 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/*
+** External commands are started with posix_spawn(). glibc does it with
+** clone(CLONE_VM | CLONE_VFORK): the child runs in the memory of the
+** shell until execve(), no page table is copied, so the cost does not
+** grow with the size of the shell. What the forked child used to do
+** before execve() (redirections, pipe ends, signals, env) is expressed
+** as file actions and attributes. The caller only forks as before when
+** no child could be started at all (see spawn_failed()): a redirection
+** that can not be opened or a file that can not be executed is reported
+** here, with the messages the forked child prints. With
+** MINISHELL_LAUNCHER set, a launcher process starts them instead (see
+** launcher.c).
+*/
+
+/**
+** init_spawn - Empty file actions, attributes resetting the signals
+**
+**   SIGINT and SIGQUIT go back to their default like in
+**   reset_signals_for_child(), and so does SIGPIPE, ignored by the shell.
+**
+**   sp - Spawn to prepare, sp->stage set
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	init_spawn(t_spawn *sp)
+{
+	sigset_t	defaults;
+
+	sp->fds = NULL;
+	sp->fd_count = 0;
+	sp->std[STDIN_FILENO] = STDIN_FILENO;
+	sp->std[STDOUT_FILENO] = STDOUT_FILENO;
+	sp->error = 0;
+	sp->status = 0;
+	if (posix_spawn_file_actions_init(&sp->actions) != 0)
+		return (0);
+	if (posix_spawnattr_init(&sp->attr) != 0)
+		return (posix_spawn_file_actions_destroy(&sp->actions), 0);
+	sigemptyset(&defaults);
+	sigaddset(&defaults, SIGINT);
+	sigaddset(&defaults, SIGQUIT);
+	sigaddset(&defaults, SIGPIPE);
+	if (posix_spawnattr_setsigdefault(&sp->attr, &defaults) != 0
+		|| posix_spawnattr_setflags(&sp->attr, POSIX_SPAWN_SETSIGDEF) != 0)
+		return (end_spawn(sp), 0);
+	return (1);
+}
+
+/**
+** start_cmd - Have the launcher start the command, or posix_spawn() it
+**
+**   The launcher is only asked by the shell itself: a command started
+**   for a forked child would not be a child of that process. If the
+**   launcher fails, posix_spawn() is tried.
+**
+**   shell - Shell state structure
+**   path  - Executable path
+**   av    - Arguments of the command
+**   sp    - Prepared spawn, sp->error set on failure
+**
+**   Returns: pid of the command, -1 on failure
+*/
+static pid_t	start_cmd(t_shell *shell, char *path, char **av, t_spawn *sp)
+{
+	pid_t	pid;
+
+	if (shell->launcher >= 0 && shell->pid == getpid())
+	{
+		pid = launch_cmd(shell, path, av, sp);
+		if (pid > 0)
+			return (pid);
+	}
+	sp->error = posix_spawn(&pid, path, &sp->actions, &sp->attr, av,
+			shell->env);
+	if (sp->error)
+		return (-1);
+	return (pid);
+}
+
+/**
+** spawn_with_env - Start the command with the prefix assignments in the env
+**
+**   The child does not get a copy of the env to change, so the shell
+**   puts the assignments in its own (see push_env_overlay()) just for
+**   the call and puts it back after. start_cmd() returns once the
+**   command was executed or the launcher has a copy of the env. A file
+**   of the command hash that can not be executed any more is looked for
+**   again and tried once more (see spawn_failed()).
+**
+**   shell - Shell state structure
+**   cmd   - Command
+**   path  - Executable path
+**   sp    - Prepared spawn
+**
+**   Returns: pid of the command, -1 on failure (sp->status set)
+*/
+static pid_t	spawn_with_env(t_shell *shell, t_cmd *cmd, char *path,
+		t_spawn *sp)
+{
+	char	**saved;
+	pid_t	pid;
+
+	if (!push_env_overlay(shell, cmd, &saved))
+	{
+		sp->status = 1;
+		return (-1);
+	}
+	pid = start_cmd(shell, path, cmd->cmd_av, sp);
+	if (pid < 0)
+		path = spawn_failed(shell, cmd, sp, 1);
+	if (pid < 0 && path)
+	{
+		pid = start_cmd(shell, path, cmd->cmd_av, sp);
+		if (pid < 0)
+			spawn_failed(shell, cmd, sp, 0);
+	}
+	pop_env_overlay(shell, saved);
+	return (pid);
+}
+
+/**
+** spawn_cmd - Start an external command without fork()
+**
+**   Once a redirection file was opened the command is not forked any
+**   more: it would open them all again.
+**
+**   shell - Shell state structure (shell_env() done)
+**   cmd   - Command
+**   path  - Executable path, already checked
+**   sp    - Spawn, sp->stage set to the index of the command in the
+**           pipeline, -1 when alone
+**
+**   Returns: pid of the command, -1 on failure: sp->status is the exit
+**   status of an error already reported, 0 if the caller has to fork
+*/
+pid_t	spawn_cmd(t_shell *shell, t_cmd *cmd, char *path, t_spawn *sp)
+{
+	pid_t	pid;
+
+	if (!init_spawn(sp))
+		return (-1);
+	pid = -1;
+	if (add_pipe_actions(shell, sp, sp->stage))
+	{
+		if (add_redir_actions(shell, cmd, sp))
+			pid = spawn_with_env(shell, cmd, path, sp);
+		else
+			sp->status = 1;
+	}
+	end_spawn(sp);
+	return (pid);
+}
+
+/**
+** spawn_stage - Start one command of a pipeline without fork()
+**
+**   Only external commands that were found and can be executed are
+**   spawned. Builtins, empty commands and commands that were not found
+**   are left to fork_pipeline_child(), and so is a command no child
+**   could be started for. A command that failed for good is done: its
+**   exit status is left in its stage (see join_thread_stage()).
+**
+**   shell - Shell state structure
+**   cmd   - Command
+**   stage - Index of the command in the pipeline
+**
+**   Returns: pid of the command, 0 when it is done, -1 if the caller
+**   has to fork
+*/
+pid_t	spawn_stage(t_shell *shell, t_cmd *cmd, int stage)
+{
+	t_spawn	sp;
+	t_stat	st;
+	char	*path;
+	pid_t	pid;
+
+	if (!cmd->cmd_av || !cmd->cmd_av[0] || is_builtin(cmd->cmd_av[0]))
+		return (-1);
+	path = find_cmd_executable(shell, cmd, &st);
+	if (!path || !S_ISREG(st.st_mode) || !(st.st_mode & S_IXUSR))
+		return (-1);
+	sp.stage = stage;
+	pid = spawn_cmd(shell, cmd, path, &sp);
+	if (pid > 0 || !sp.status)
+		return (pid);
+	shell->pipe_stages[stage].status = sp.status;
+	shell->pipe_stages[stage].done = 1;
+	return (0);
+}
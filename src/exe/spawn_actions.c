@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn_actions.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 15:20:44 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/10 15:20:46 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** count_redirs - Number of redirections of a command
+**
+**   cmd - Command
+**
+**   Returns: The number
+*/
+static int	count_redirs(t_cmd *cmd)
+{
+	t_redir	*redir;
+	int		count;
+
+	count = 0;
+	redir = cmd->redirections;
+	while (redir)
+	{
+		count++;
+		redir = redir->next;
+	}
+	return (count);
+}
+
+/**
+** add_redir - Open the file of one redirection and dup2 it in the file
+** actions
+**
+**   sp    - Spawn being prepared
+**   redir - Redirection
+**   cmd   - Command it belongs to
+**
+**   Returns: 1 on success, 0 on failure (reported)
+*/
+static int	add_redir(t_spawn *sp, t_redir *redir, t_cmd *cmd)
+{
+	int	fd;
+	int	target;
+
+	fd = open_redir_fd(redir, cmd);
+	if (fd < 0)
+		return (redir_error(redir, cmd), 0);
+	sp->fds[sp->fd_count++] = fd;
+	target = STDIN_FILENO;
+	if (redir->tok_type == TOKEN_REDIRECT_OUT
+		|| redir->tok_type == TOKEN_APPEND)
+		target = STDOUT_FILENO;
+	sp->std[target] = fd;
+	if (posix_spawn_file_actions_adddup2(&sp->actions, fd, target) != 0)
+		return (print_error("minishell", NULL, "Cannot allocate memory"), 0);
+	return (1);
+}
+
+/**
+** add_redir_actions - Put the redirections of a command in its file
+** actions, in order
+**
+**   The files are opened now and kept in sp->fds, for end_spawn() to
+**   close once the command runs. sp->std follows the last one of each
+**   direction. Like setup_redirections(), the first file that can not
+**   be opened is reported and stops the command.
+**
+**   shell - Shell state structure
+**   cmd   - Command
+**   sp    - Spawn being prepared
+**
+**   Returns: 1 on success, 0 on failure (reported)
+*/
+int	add_redir_actions(t_shell *shell, t_cmd *cmd, t_spawn *sp)
+{
+	t_redir	*redir;
+
+	sp->fds = ar_alloc(shell->arena, sizeof(int) * (count_redirs(cmd) + 1));
+	if (!sp->fds)
+		return (print_error("minishell", NULL, "Cannot allocate memory"), 0);
+	redir = cmd->redirections;
+	while (redir)
+	{
+		if (!add_redir(sp, redir, cmd))
+			return (0);
+		redir = redir->next;
+	}
+	return (1);
+}
+
+/**
+** add_pipe_actions - Connect a pipeline stage to its pipes
+**
+**   The file actions do what fork_pipeline_child() does: stdin from the
+**   previous pipe, stdout to the next one, then every pipe end closed.
+**   sp->std is set to the same pipe ends.
+**
+**   shell - Shell state structure (pipe_array, pipe_count)
+**   sp    - Spawn being prepared
+**   stage - Index of the command in the pipeline, -1 for none
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	add_pipe_actions(t_shell *shell, t_spawn *sp, int stage)
+{
+	int	i;
+
+	if (stage < 0)
+		return (1);
+	if (stage > 0)
+		sp->std[STDIN_FILENO] = shell->pipe_array[stage - 1][0];
+	if (stage < shell->pipe_count)
+		sp->std[STDOUT_FILENO] = shell->pipe_array[stage][1];
+	if ((stage > 0 && posix_spawn_file_actions_adddup2(&sp->actions,
+				sp->std[STDIN_FILENO], STDIN_FILENO) != 0)
+		|| (stage < shell->pipe_count && posix_spawn_file_actions_adddup2(
+				&sp->actions, sp->std[STDOUT_FILENO], STDOUT_FILENO) != 0))
+		return (0);
+	i = 0;
+	while (i < shell->pipe_count)
+	{
+		if (posix_spawn_file_actions_addclose(&sp->actions,
+				shell->pipe_array[i][0]) != 0
+			|| posix_spawn_file_actions_addclose(&sp->actions,
+				shell->pipe_array[i][1]) != 0)
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
+/**
+** end_spawn - Close the redirection files and free the spawn state
+**
+**   sp - Spawn, prepared by init_spawn()
+*/
+void	end_spawn(t_spawn *sp)
+{
+	while (sp->fd_count > 0)
+		close(sp->fds[--sp->fd_count]);
+	posix_spawn_file_actions_destroy(&sp->actions);
+	posix_spawnattr_destroy(&sp->attr);
+}
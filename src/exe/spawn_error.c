@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn_error.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/17 10:12:40 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/17 10:12:42 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** spawn_failed - Decide what to do about a command that did not start
+**
+**   posix_spawn() gives the error of execve() as well as its own. Only
+**   when no child could be made (EAGAIN, ENOMEM, ENOSYS) does the caller
+**   fork: anything else would fail the same way in a forked child. A
+**   file that is gone or not executable any more may come from a stale
+**   entry of the command hash (a chmod is not watched), so the command
+**   is looked for again and checked like the first time, the way
+**   execute_child_process() does. Other errors get its message.
+**
+**   shell - Shell state structure
+**   cmd   - Command
+**   sp    - Spawn, sp->error set; sp->status is set here
+**   retry - 1 if the command may be looked for again
+**
+**   Returns: Path to try once more, NULL when done
+*/
+char	*spawn_failed(t_shell *shell, t_cmd *cmd, t_spawn *sp, int retry)
+{
+	t_stat	st;
+	char	*path;
+
+	sp->status = 0;
+	if (sp->error == EAGAIN || sp->error == ENOMEM || sp->error == ENOSYS)
+		return (NULL);
+	if (retry && (sp->error == EACCES || sp->error == ENOENT)
+		&& !ft_strchr(cmd->cmd_av[0], '/'))
+	{
+		forget_hashed(shell, cmd->cmd_av[0]);
+		path = find_cmd_executable(shell, cmd, &st);
+		sp->status = validate_executable_path(cmd->cmd_av[0], path, &st);
+		if (sp->status == 0)
+			return (path);
+		return (NULL);
+	}
+	errno = sp->error;
+	perror("minishell: execve");
+	sp->status = 126;
+	return (NULL);
+}
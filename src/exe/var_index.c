@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   var_index.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/06 14:12:08 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/07 11:20:31 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** str_hash - FNV-1a hash of the first len bytes of s
+**
+**   Used for variable names here and command names in cmd_hash.c.
+*/
+unsigned int	str_hash(char *s, int len)
+{
+	unsigned int	hash;
+	int				i;
+
+	hash = 2166136261u;
+	i = 0;
+	while (i < len)
+		hash = (hash ^ (unsigned char)s[i++]) * 16777619u;
+	return (hash);
+}
+
+/**
+** var_index_slot - Find the hash slot of a variable
+**
+**   Open addressing with linear probing. Slots of unset variables
+**   (VAR_GONE) are stepped over, the probe ends at the first VAR_EMPTY.
+**
+**   shell - Shell state structure
+**   name  - Variable name, only the first len bytes are used
+**   len   - Length of the name
+**
+**   Returns: Slot in shell->var_index, -1 if the variable is not set
+*/
+int	var_index_slot(t_shell *shell, char *name, int len)
+{
+	unsigned int	slot;
+	unsigned int	mask;
+	int				pos;
+
+	if (!shell->var_slots)
+		return (-1);
+	mask = shell->var_slots - 1;
+	slot = str_hash(name, len) & mask;
+	while (shell->var_index[slot] != VAR_EMPTY)
+	{
+		pos = shell->var_index[slot];
+		if (pos != VAR_GONE && shell->vars[pos].name_len == len
+			&& ft_strncmp(shell->vars[pos].entry, name, len) == 0)
+			return ((int)slot);
+		slot = (slot + 1) & mask;
+	}
+	return (-1);
+}
+
+/**
+** var_index_add - Add the variable at position pos to the hash index
+**
+**   The caller made sure the name is not indexed yet, so the first free
+**   slot (empty or left by an unset variable) is taken.
+**
+**   shell - Shell state structure
+**   pos   - Position of the variable in shell->vars
+*/
+void	var_index_add(t_shell *shell, int pos)
+{
+	unsigned int	slot;
+	unsigned int	mask;
+
+	mask = shell->var_slots - 1;
+	slot = str_hash(shell->vars[pos].entry, shell->vars[pos].name_len) & mask;
+	while (shell->var_index[slot] >= 0)
+		slot = (slot + 1) & mask;
+	shell->var_index[slot] = pos;
+}
+
+/**
+** var_index_reserve - Make sure the index fits a table of capacity cap
+**
+**   The index has a power of two number of slots, at least twice the
+**   capacity of the variable table. Slots are only taken by variables
+**   and by the VAR_GONE marks of unset ones, never more than the table
+**   holds, so the index is never more than half full.
+**   Nothing changes on failure, so the caller can back out cleanly.
+**
+**   shell - Shell state structure
+**   cap   - Capacity the variable table is about to have
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	var_index_reserve(t_shell *shell, int cap)
+{
+	int	*slots;
+	int	count;
+
+	count = VAR_MIN_SLOTS;
+	while (count < cap * 2)
+		count *= 2;
+	if (count <= shell->var_slots)
+		return (1);
+	slots = malloc(sizeof(int) * count);
+	if (!slots)
+		return (0);
+	free(shell->var_index);
+	shell->var_index = slots;
+	shell->var_slots = count;
+	return (1);
+}
+
+/**
+** var_index_fill - Rebuild the hash index from the variable table
+**
+**   Used after the table moved or was compacted, this also drops the
+**   VAR_GONE marks of unset variables.
+**
+**   shell - Shell state structure
+*/
+void	var_index_fill(t_shell *shell)
+{
+	int	i;
+
+	ft_memset(shell->var_index, 0xff, sizeof(int) * shell->var_slots);
+	i = 0;
+	while (i < shell->var_count)
+	{
+		if (shell->vars[i].entry)
+			var_index_add(shell, i);
+		i++;
+	}
+}
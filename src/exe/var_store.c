@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   var_store.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/07 10:48:12 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/07 11:20:02 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/**
+** compact_vars - Close the holes unset variables left in the table
+**
+**   Keeps the order of the variables, which is the order env shows.
+**
+**   shell - Shell state structure
+*/
+static void	compact_vars(t_shell *shell)
+{
+	int	i;
+	int	live;
+
+	i = 0;
+	live = 0;
+	while (i < shell->var_count)
+	{
+		if (shell->vars[i].entry)
+			shell->vars[live++] = shell->vars[i];
+		i++;
+	}
+	shell->var_count = live;
+}
+
+/**
+** reserve_var - Make room for one more variable in the table
+**
+**   When the table is full it is compacted if at least half of it are
+**   holes, otherwise it doubles. Either way it happens at most once per
+**   half a table of new variables, so adding stays O(1) amortized.
+**
+**   shell - Shell state structure
+**
+**   Returns: 1 on success, 0 on failure
+*/
+static int	reserve_var(t_shell *shell)
+{
+	t_var	*bigger;
+	int		new_cap;
+
+	if (shell->var_count < shell->var_cap)
+		return (1);
+	if (shell->var_count && shell->var_live <= shell->var_count / 2)
+		return (compact_vars(shell), var_index_fill(shell), 1);
+	new_cap = VAR_FIRST_CAP;
+	if (shell->var_cap)
+		new_cap = shell->var_cap * 2;
+	bigger = malloc(sizeof(t_var) * new_cap);
+	if (!bigger || !var_index_reserve(shell, new_cap))
+		return (free(bigger), 0);
+	compact_vars(shell);
+	if (shell->var_count)
+		ft_memcpy(bigger, shell->vars, sizeof(t_var) * shell->var_count);
+	free(shell->vars);
+	shell->vars = bigger;
+	shell->var_cap = new_cap;
+	var_index_fill(shell);
+	return (1);
+}
+
+/**
+** var_store_add - Add a new variable to the table
+**
+**   shell      - Shell state structure
+**   entry      - Heap string "NAME=value", or "NAME" for no value; the
+**                table owns it from here on
+**   name_len   - Length of NAME
+**   equal_sign - 1 if the variable has a value
+**
+**   Returns: Position of the variable, -1 on failure (entry not taken)
+*/
+int	var_store_add(t_shell *shell, char *entry, int name_len, int equal_sign)
+{
+	int	pos;
+
+	if (!reserve_var(shell))
+		return (-1);
+	pos = shell->var_count++;
+	shell->vars[pos].entry = entry;
+	shell->vars[pos].name_len = name_len;
+	shell->vars[pos].len = ft_strlen(entry);
+	shell->vars[pos].size = shell->vars[pos].len + 1;
+	shell->vars[pos].env_pos = -1;
+	shell->vars[pos].equal_sign = equal_sign;
+	shell->var_live++;
+	shell->var_gen++;
+	var_index_add(shell, pos);
+	return (pos);
+}
+
+/**
+** var_store_set_value - Give a variable that has a value a new one
+**
+**   The value is written into the entry in place when it fits, so
+**   assigning a variable again and again does not allocate. Otherwise
+**   the entry moves to a bigger block with some room to spare. value
+**   may point into the old entry, it is copied before that is freed.
+**
+**   shell - Shell state structure
+**   pos   - Position of the variable in shell->vars
+**   value - New value
+**
+**   Returns: 1 on success, 0 on failure
+*/
+int	var_store_set_value(t_shell *shell, int pos, char *value)
+{
+	t_var	*var;
+	char	*entry;
+	int		len;
+
+	var = &shell->vars[pos];
+	len = var->name_len + 1 + ft_strlen(value);
+	entry = var->entry;
+	if (len + 1 > var->size)
+	{
+		entry = malloc(len + 1 + len / 2);
+		if (!entry)
+			return (0);
+		ft_memcpy(entry, var->entry, var->name_len + 1);
+	}
+	ft_memmove(entry + var->name_len + 1, value, len - var->name_len);
+	if (entry != var->entry)
+	{
+		free(var->entry);
+		var->entry = entry;
+		var->size = len + 1 + len / 2;
+	}
+	var->len = len;
+	shell->var_gen++;
+	return (1);
+}
+
+/**
+** free_var_store - Free every variable, the table, its index and the env
+**
+**   shell - Shell state structure
+*/
+void	free_var_store(t_shell *shell)
+{
+	int	i;
+
+	i = 0;
+	while (i < shell->var_count)
+		free(shell->vars[i++].entry);
+	free(shell->vars);
+	free(shell->var_index);
+	free(shell->env);
+}
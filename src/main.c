@@ -33,6 +33,7 @@ int	main(int ac, char **av, char **env)
 		free_shell(shell);
 		return (1);
 	}
+	init_completion(shell);
 	while (1337)
 		shell_loop(shell);
 	exit_status = shell->last_exit_status;
@@ -51,23 +52,26 @@ static void	shell_loop(t_shell *shell)
 	{
 		ft_printf("exit\n");
 		exit_status = shell->last_exit_status;
+		memstats_at_exit(shell);
 		rl_clear_history();
 		free_shell(shell);
 		exit(exit_status);
 	}
 	handle_signal_status(shell);
+	drain_path_events(shell);
 	if (*input)
 		add_history(input);
 	process_input(shell, input);
 	free(input);
 	ar_reset(shell->arena);
+	init_completion(shell);
 }
 
 static int	process_input(t_shell *shell, char *input)
 {
-	t_tokens	*tokens;
-	t_cmd_table	*cmd_table;
-	int			possible_error;
+	t_token_list	*tokens;
+	t_cmd_table		*cmd_table;
+	int				possible_error;
 
 	tokens = tokenize_input(shell, input);
 	if (!tokens)
@@ -75,6 +79,7 @@ static int	process_input(t_shell *shell, char *input)
 	cmd_table = ar_alloc(shell->arena, sizeof(t_cmd_table));
 	if (!cmd_table)
 		return (err_msg_n_return_value("Memalloc failed for t_cmd_table\n", 1));
+	ar_set_phase(shell->arena, AR_PARSE);
 	possible_error = register_to_table(shell, tokens, cmd_table);
 	if (possible_error == 2)
 	{
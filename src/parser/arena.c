@@ -12,6 +12,9 @@
 
 #include "minishell.h"
 
+/* Create the arena with one small chunk. Later chunks are only added when a
+command actually needs them, so an idle shell keeps AR_FIRST_SIZE bytes.
+*/
 t_arena	*ar_init(void)
 {
 	t_arena	*arena;
@@ -19,85 +22,88 @@ t_arena	*ar_init(void)
 	arena = ft_calloc(1, sizeof(t_arena));
 	if (!arena)
 		return (NULL);
-	arena->size = AR_SIZE;
-	arena->buffer = ft_calloc(1, arena->size);
-	if (!arena->buffer)
+	arena->head = ar_new_chunk(AR_FIRST_SIZE);
+	if (!arena->head)
 	{
 		free(arena);
 		return (NULL);
 	}
-	arena->offset = 0;
+	arena->current = arena->head;
+	arena->large = NULL;
+	arena->trim_window = AR_TRIM_WINDOW;
 	return (arena);
 }
 
+/* Hand out 8-byte aligned, zeroed memory.
+- Requests of AR_LARGE bytes or more get a dedicated block
+- Otherwise bump the current chunk, which is the common, O(1) case
+- When the current chunk is full, move the cursor to the next chunk
+Every request is counted in the arena stats, see arena_stats.c
+
+Return: pointer to the memory, NULL on errors
+*/
 void	*ar_alloc(t_arena *arena, size_t bytes)
 {
-	void	*ptr;
-	t_arena	*current;
-	t_arena	*new_arena;
+	void		*ptr;
+	t_ar_chunk	*current;
+	size_t		requested;
 
-	ptr = NULL;
-	if (normally_fit_in_arena(arena, &ptr, &bytes) == 1)
-		return (ptr);
-	current = arena;
-	while (current->next)
-	{
-		current = current->next;
-		if (current->offset + bytes <= current->size)
-		{
-			ptr = current->buffer + current->offset;
-			current->offset += bytes;
-			return (ptr);
-		}
-	}
-	new_arena = ar_init();
-	if (!new_arena)
+	if (!arena)
 		return (NULL);
-	current->next = new_arena;
-	ptr = new_arena->buffer + new_arena->offset;
-	new_arena->offset += bytes;
-	return (ptr);
-}
-
-int	normally_fit_in_arena(t_arena *arena, void **ptr, size_t *bytes)
-{
-	*bytes = (*bytes + 7) & ~7;
-	if (*bytes > AR_SIZE)
-		return (err_msg_n_return_value("Error: Allocation request "
-				"exceeds maximum arena size\n", 1));
-	if (arena->offset + *bytes <= arena->size)
+	requested = bytes;
+	bytes = (bytes + 7) & ~((size_t)7);
+	ar_count(arena, requested, bytes);
+	if (bytes >= AR_LARGE)
+		return (ar_alloc_large(arena, bytes));
+	current = arena->current;
+	if (current->offset + bytes <= current->size)
 	{
-		*ptr = arena->buffer + arena->offset;
-		arena->offset += *bytes;
-		return (1);
+		ptr = current->buffer + current->offset;
+		current->offset += bytes;
+		return (ptr);
 	}
-	return (0);
+	return (ar_alloc_next_chunk(arena, bytes));
 }
 
 void	free_arena(t_arena *arena)
 {
-	t_arena	*tmp;
+	t_ar_chunk	*tmp;
 
-	while (arena)
+	if (!arena)
+		return ;
+	ar_free_large(arena);
+	while (arena->head)
 	{
-		tmp = arena->next;
-		if (arena->buffer)
-		{
-			free(arena->buffer);
-			arena->buffer = NULL;
-		}
-		free (arena);
-		arena = tmp;
+		tmp = arena->head->next;
+		free(arena->head);
+		arena->head = tmp;
 	}
-	arena = NULL;
+	free(arena);
 }
 
+/* Make every chunk reusable for the next prompt line.
+Allocation only ever bumps offset forward, so [0, offset) is exactly the part
+of a chunk the last command touched. Only that range is cleared (callers rely
+on ar_alloc() handing out zeroed memory). Dedicated large blocks are freed,
+chunks nobody needed lately are trimmed and the cursor goes back to the first
+chunk.
+*/
 void	ar_reset(t_arena *arena)
 {
-	while (arena)
+	t_ar_chunk	*chunk;
+
+	if (!arena)
+		return ;
+	ar_stats_end_command(arena);
+	ar_free_large(arena);
+	ar_trim_chunks(arena);
+	chunk = arena->head;
+	while (chunk)
 	{
-		ft_bzero(arena->buffer, AR_SIZE);
-		arena->offset = 0;
-		arena = arena->next;
+		if (chunk->offset)
+			ft_bzero(chunk->buffer, chunk->offset);
+		chunk->offset = 0;
+		chunk = chunk->next;
 	}
+	arena->current = arena->head;
 }
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_chunk.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/05 10:12:03 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/05 10:12:05 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Allocate a chunk header and its zeroed buffer in one block
+*/
+t_ar_chunk	*ar_new_chunk(size_t size)
+{
+	t_ar_chunk	*chunk;
+
+	chunk = ft_calloc(1, sizeof(t_ar_chunk) + size);
+	if (!chunk)
+		return (NULL);
+	chunk->buffer = (char *)(chunk + 1);
+	chunk->size = size;
+	chunk->offset = 0;
+	chunk->next = NULL;
+	return (chunk);
+}
+
+/* The current chunk is full: advance the cursor to the next chunk that fits.
+Chunks kept from earlier commands are reused first, otherwise a new chunk
+twice the size of the last one (capped at AR_MAX_CHUNK) is appended.
+(helper function of ar_alloc(), bytes is already aligned and < AR_LARGE)
+
+Return: pointer to the memory, NULL on errors
+*/
+void	*ar_alloc_next_chunk(t_arena *arena, size_t bytes)
+{
+	t_ar_chunk	*chunk;
+	size_t		size;
+
+	chunk = arena->current;
+	while (chunk->next && chunk->next->offset + bytes > chunk->next->size)
+		chunk = chunk->next;
+	if (!chunk->next)
+	{
+		size = chunk->size * 2;
+		while (size < bytes)
+			size *= 2;
+		if (size > AR_MAX_CHUNK)
+			size = AR_MAX_CHUNK;
+		chunk->next = ar_new_chunk(size);
+		if (!chunk->next)
+			return (err_msg_n_return_null("Memalloc failed for arena chunk\n"));
+	}
+	arena->current = chunk->next;
+	arena->current->offset = bytes;
+	return (arena->current->buffer);
+}
+
+/* Give an oversized request its own zeroed block, so it never wastes or
+outgrows a chunk. The block is linked to the arena and freed on reset.
+
+Return: pointer to the memory, NULL on errors
+*/
+void	*ar_alloc_large(t_arena *arena, size_t bytes)
+{
+	t_ar_large	*block;
+
+	block = ft_calloc(1, sizeof(t_ar_large) + bytes);
+	if (!block)
+		return (err_msg_n_return_null("Memalloc failed for large block\n"));
+	block->size = bytes;
+	block->next = arena->large;
+	arena->large = block;
+	return (block + 1);
+}
+
+/* Release every dedicated large block of the arena
+*/
+void	ar_free_large(t_arena *arena)
+{
+	t_ar_large	*tmp;
+
+	while (arena->large)
+	{
+		tmp = arena->large->next;
+		free(arena->large);
+		arena->large = tmp;
+	}
+}
+
+/* Grow the allocation at ptr from old_size to new_size without moving it.
+Only possible when ptr is the last allocation of the current chunk and the
+chunk still has room: then the cursor is simply bumped further.
+
+Return: 1 if the allocation was extended, 0 if the caller has to move it
+*/
+int	ar_extend(t_arena *arena, void *ptr, size_t old_size, size_t new_size)
+{
+	t_ar_chunk	*current;
+
+	old_size = (old_size + 7) & ~((size_t)7);
+	new_size = (new_size + 7) & ~((size_t)7);
+	current = arena->current;
+	if ((char *)ptr + old_size != current->buffer + current->offset)
+		return (0);
+	if (current->offset - old_size + new_size > current->size)
+		return (0);
+	ar_count_bytes(arena, new_size - old_size, new_size - old_size);
+	current->offset = current->offset - old_size + new_size;
+	return (1);
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_mark.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/06 19:02:47 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/06 19:02:50 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Remember the current end of the arena, so the scratch memory allocated
+after this point can be given back with ar_rollback()
+*/
+t_ar_mark	ar_mark(t_arena *arena)
+{
+	t_ar_mark	mark;
+
+	mark.chunk = arena->current;
+	mark.offset = arena->current->offset;
+	mark.large = arena->large;
+	return (mark);
+}
+
+/* Give back everything allocated since the mark was taken:
+- free the large blocks created after the mark
+- clear and rewind the used part of the mark chunk and of every chunk the
+cursor moved to after it, then put the cursor back on the mark chunk
+Cleared memory keeps the promise that ar_alloc() returns zeroed bytes.
+*/
+void	ar_rollback(t_arena *arena, t_ar_mark mark)
+{
+	t_ar_chunk	*chunk;
+	t_ar_large	*tmp;
+
+	while (arena->large && arena->large != mark.large)
+	{
+		tmp = arena->large->next;
+		ar_uncount(arena, arena->large->size);
+		free(arena->large);
+		arena->large = tmp;
+	}
+	chunk = mark.chunk;
+	if (chunk->offset > mark.offset)
+	{
+		ar_uncount(arena, chunk->offset - mark.offset);
+		ft_bzero(chunk->buffer + mark.offset, chunk->offset - mark.offset);
+	}
+	chunk->offset = mark.offset;
+	while (chunk != arena->current)
+	{
+		chunk = chunk->next;
+		ar_uncount(arena, chunk->offset);
+		ft_bzero(chunk->buffer, chunk->offset);
+		chunk->offset = 0;
+	}
+	arena->current = mark.chunk;
+}
+
+/* Slow path of ar_rollback_keep(): the result does not fit right at the mark,
+so park it on the heap while the arena is rolled back
+(helper function of ar_rollback_keep())
+*/
+static char	*keep_through_heap(t_arena *arena, t_ar_mark mark, char *keep)
+{
+	char	*tmp;
+	char	*result;
+
+	tmp = ft_strdup(keep);
+	ar_rollback(arena, mark);
+	if (!tmp)
+		return (err_msg_n_return_null("Memalloc failed keeping string\n"));
+	result = ar_strdup(arena, tmp);
+	free(tmp);
+	return (result);
+}
+
+/* Roll back to the mark but keep one string that was built after it (for
+example the final result of an expansion pass). The string is moved down to
+the mark, so only its bytes stay in use and all the scratch behind it is
+reclaimed.
+
+Return: the kept string at its new place, NULL if keep is NULL or on errors
+*/
+char	*ar_rollback_keep(t_arena *arena, t_ar_mark mark, char *keep)
+{
+	size_t	len;
+	size_t	bytes;
+	char	*dest;
+
+	if (!keep)
+	{
+		ar_rollback(arena, mark);
+		return (NULL);
+	}
+	len = ft_strlen(keep) + 1;
+	bytes = (len + 7) & ~((size_t)7);
+	if (bytes >= AR_LARGE || mark.offset + bytes > mark.chunk->size)
+		return (keep_through_heap(arena, mark, keep));
+	dest = mark.chunk->buffer + mark.offset;
+	ft_memmove(dest, keep, len);
+	mark.offset += bytes;
+	ar_rollback(arena, mark);
+	return (dest);
+}
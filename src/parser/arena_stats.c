@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_stats.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/06 09:31:17 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/06 09:31:19 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Attribute the following allocations to another part of the shell.
+Callers that only run for a while (expansion inside parsing, heredocs inside
+execution) put the returned phase back when they are done.
+
+Return: the phase that was active before
+*/
+t_ar_phase	ar_set_phase(t_arena *arena, t_ar_phase phase)
+{
+	t_ar_phase	previous;
+
+	previous = arena->phase;
+	arena->phase = phase;
+	return (previous);
+}
+
+/* Record an allocation of the current command: one more block handed out,
+plus its bytes
+*/
+void	ar_count(t_arena *arena, size_t requested, size_t aligned)
+{
+	arena->stats.allocs++;
+	ar_count_bytes(arena, requested, aligned);
+}
+
+/* Record bytes the current command took, without a new block (the in-place
+growth of ar_extend() lands here directly)
+*/
+void	ar_count_bytes(t_arena *arena, size_t requested, size_t aligned)
+{
+	t_ar_stats	*stats;
+
+	stats = &arena->stats;
+	stats->requested += requested;
+	stats->aligned += aligned;
+	stats->phase[arena->phase] += aligned;
+	stats->live += aligned;
+	if (stats->live > stats->cmd_peak)
+		stats->cmd_peak = stats->live;
+}
+
+/* Record memory given back before the end of the command (rollback)
+*/
+void	ar_uncount(t_arena *arena, size_t aligned)
+{
+	if (aligned > arena->stats.live)
+		aligned = arena->stats.live;
+	arena->stats.live -= aligned;
+}
+
+/* Close the books of the command that just finished: keep its peak and start
+the next command from zero, attributed to tokenizing again
+(helper function of ar_reset())
+*/
+void	ar_stats_end_command(t_arena *arena)
+{
+	t_ar_stats	*stats;
+
+	stats = &arena->stats;
+	stats->last_peak = stats->cmd_peak;
+	if (stats->cmd_peak > stats->max_peak)
+		stats->max_peak = stats->cmd_peak;
+	stats->cmd_peak = 0;
+	stats->live = 0;
+	stats->commands++;
+	arena->phase = AR_TOKENIZE;
+}
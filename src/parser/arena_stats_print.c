@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_stats_print.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/06 09:48:02 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/06 09:48:04 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Write an unsigned number in decimal (ft_putnbr_fd() stops at INT_MAX)
+*/
+static void	put_size(size_t n, int fd)
+{
+	if (n >= 10)
+		put_size(n / 10, fd);
+	ft_putchar_fd('0' + n % 10, fd);
+}
+
+/* Write one "label: value" line
+*/
+static void	put_stat(char *label, size_t value, int fd)
+{
+	ft_putstr_fd(label, fd);
+	ft_putstr_fd(": ", fd);
+	put_size(value, fd);
+	ft_putchar_fd('\n', fd);
+}
+
+/* Walk the chunk chain to report what the chunks hold from the system
+*/
+static void	print_chunks(t_arena *arena, int fd)
+{
+	t_ar_chunk	*chunk;
+	size_t		count;
+	size_t		bytes;
+
+	count = 0;
+	bytes = 0;
+	chunk = arena->head;
+	while (chunk)
+	{
+		count++;
+		bytes += chunk->size;
+		chunk = chunk->next;
+	}
+	put_stat("chunks", count, fd);
+	put_stat("chunk_bytes", bytes, fd);
+}
+
+/* Same for the dedicated large blocks of the current command
+*/
+static void	print_large(t_arena *arena, int fd)
+{
+	t_ar_large	*large;
+	size_t		count;
+	size_t		bytes;
+
+	count = 0;
+	bytes = 0;
+	large = arena->large;
+	while (large)
+	{
+		count++;
+		bytes += large->size;
+		large = large->next;
+	}
+	put_stat("large_blocks", count, fd);
+	put_stat("large_bytes", bytes, fd);
+}
+
+/* Print the arena counters as "label: value" lines, one per counter, so the
+output is easy to grep and to compare between runs.
+- layout: chunks and large blocks currently held
+- session totals: allocations, requested and aligned bytes, bytes per phase
+- peaks: live bytes of the current command, its peak, the previous command's
+peak and the session maximum
+*/
+void	ar_stats_print(t_arena *arena, int fd)
+{
+	t_ar_stats	*stats;
+
+	stats = &arena->stats;
+	print_chunks(arena, fd);
+	print_large(arena, fd);
+	put_stat("allocs", stats->allocs, fd);
+	put_stat("requested", stats->requested, fd);
+	put_stat("aligned", stats->aligned, fd);
+	put_stat("phase_tokenize", stats->phase[AR_TOKENIZE], fd);
+	put_stat("phase_parse", stats->phase[AR_PARSE], fd);
+	put_stat("phase_expand", stats->phase[AR_EXPAND], fd);
+	put_stat("phase_heredoc", stats->phase[AR_HEREDOC], fd);
+	put_stat("phase_exec", stats->phase[AR_EXEC], fd);
+	put_stat("live", stats->live, fd);
+	put_stat("cmd_peak", stats->cmd_peak, fd);
+	put_stat("last_peak", stats->last_peak, fd);
+	put_stat("max_peak", stats->max_peak, fd);
+	put_stat("commands", stats->commands, fd);
+}
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_str.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/07 11:27:09 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/07 11:27:13 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Make sure the builder has room for extra more bytes plus the NUL.
+Capacity doubles, so building an N-byte string costs O(N) in total:
+- while the buffer is the newest allocation it grows in place at the tip
+- otherwise it moves to a new allocation of twice the size
+A builder that gets nothing added still ends up with a valid empty string.
+
+Return: 0 on success, -1 on errors
+*/
+int	ar_str_reserve(t_arena *arena, t_ar_str *str, size_t extra)
+{
+	size_t	need;
+	size_t	cap;
+	char	*new_buf;
+
+	need = str->len + extra + 1;
+	if (str->buf && need <= str->cap)
+		return (0);
+	cap = str->cap * 2;
+	if (cap < AR_STR_MIN)
+		cap = AR_STR_MIN;
+	while (cap < need)
+		cap *= 2;
+	if (str->buf && ar_extend(arena, str->buf, str->cap, cap))
+	{
+		str->cap = cap;
+		return (0);
+	}
+	new_buf = ar_alloc(arena, cap);
+	if (!new_buf)
+		return (-1);
+	if (str->buf)
+		ft_memcpy(new_buf, str->buf, str->len);
+	str->buf = new_buf;
+	str->cap = cap;
+	return (0);
+}
+
+/* Append one character
+Return: 0 on success, -1 on errors
+*/
+int	ar_str_putc(t_arena *arena, t_ar_str *str, char c)
+{
+	if (ar_str_reserve(arena, str, 1) == -1)
+		return (-1);
+	str->buf[str->len++] = c;
+	str->buf[str->len] = '\0';
+	return (0);
+}
+
+/* Append the first n bytes of s in one copy
+Return: 0 on success, -1 on errors
+*/
+int	ar_str_putn(t_arena *arena, t_ar_str *str, const char *s, size_t n)
+{
+	if (ar_str_reserve(arena, str, n) == -1)
+		return (-1);
+	if (n)
+		ft_memcpy(str->buf + str->len, s, n);
+	str->len += n;
+	str->buf[str->len] = '\0';
+	return (0);
+}
+
+/* Append a whole string, NULL counts as an empty string
+Return: 0 on success, -1 on errors
+*/
+int	ar_str_puts(t_arena *arena, t_ar_str *str, const char *s)
+{
+	if (!s)
+		s = "";
+	return (ar_str_putn(arena, str, s, ft_strlen(s)));
+}
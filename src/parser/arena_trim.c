@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_trim.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wshoweky <wshoweky@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/05 16:40:21 by wshoweky          #+#    #+#             */
+/*   Updated: 2025/11/05 16:40:24 by wshoweky         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Count the chunks from the head up to the cursor, i.e. the chunks the
+command that just finished allocated from
+*/
+static int	chunks_in_use(t_arena *arena)
+{
+	t_ar_chunk	*chunk;
+	int			count;
+
+	count = 1;
+	chunk = arena->head;
+	while (chunk != arena->current)
+	{
+		count++;
+		chunk = chunk->next;
+	}
+	return (count);
+}
+
+/* Retention policy: remember how many chunks each of the last trim_window
+commands used and free every chunk beyond the biggest of those counts.
+A spike (big heredoc, huge argv) grows the chain, and once it has left the
+window its chunks go back to the system instead of staying in RSS.
+(helper function of ar_reset(), called before the cursor is rewound)
+*/
+void	ar_trim_chunks(t_arena *arena)
+{
+	t_ar_chunk	*chunk;
+	t_ar_chunk	*tmp;
+	int			keep;
+	int			i;
+
+	keep = chunks_in_use(arena);
+	arena->used[arena->used_slot] = keep;
+	arena->used_slot = (arena->used_slot + 1) % arena->trim_window;
+	i = 0;
+	while (i < arena->trim_window)
+	{
+		if (arena->used[i] > keep)
+			keep = arena->used[i];
+		i++;
+	}
+	chunk = arena->head;
+	while (--keep > 0 && chunk->next)
+		chunk = chunk->next;
+	while (chunk->next)
+	{
+		tmp = chunk->next->next;
+		free(chunk->next);
+		chunk->next = tmp;
+	}
+}
+
+/* Change how many recent commands the trimming looks at, clamped to
+1..AR_TRIM_MAX. A small window gives memory back sooner after a spike, a
+large one keeps the chunks of a command that comes back now and then.
+Usage recorded outside the new window is forgotten.
+*/
+void	ar_set_trim_window(t_arena *arena, int window)
+{
+	int	i;
+
+	if (window < 1)
+		window = 1;
+	if (window > AR_TRIM_MAX)
+		window = AR_TRIM_MAX;
+	i = window;
+	while (i < AR_TRIM_MAX)
+	{
+		arena->used[i] = 0;
+		i++;
+	}
+	arena->trim_window = window;
+	if (arena->used_slot >= window)
+		arena->used_slot = 0;
+}
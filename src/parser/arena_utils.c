@@ -36,28 +36,28 @@ char	*ar_strdup(t_arena *arena, const char *str)
 //    position with the given length (or smaller if the length of the
 //    original string is less than start + length, or length is bigger
 //    than MAXSTRINGLEN).
+//    Only the bytes up to start + len are looked at, so cutting a short span
+//    out of a long line does not cost a strlen() of the whole line.
 char	*ar_substr(t_arena *arena, const char *s,
 		unsigned int start, size_t len)
 {
-	size_t	i;
 	size_t	n;
-	size_t	strlen;
 	char	*substr;
 
 	if (!s)
 		s = "";
-	strlen = ft_strlen(s);
-	if (start >= strlen)
+	n = 0;
+	while (n < start && s[n])
+		n++;
+	if (n < start)
 		return (ar_strdup(arena, ""));
-	if (len > strlen - start)
-		len = strlen - start;
-	substr = (char *)ar_alloc(arena, len + 1);
+	n = 0;
+	while (n < len && s[start + n])
+		n++;
+	substr = (char *)ar_alloc(arena, n + 1);
 	if (!substr)
 		return (NULL);
-	i = start;
-	n = 0;
-	while (s[i] && n < len)
-		substr[n++] = s[i++];
+	ft_memcpy(substr, s + start, n);
 	substr[n] = '\0';
 	return (substr);
 }
@@ -85,22 +85,3 @@ char	*ar_strjoin(t_arena *arena, const char *s1, const char *s2)
 	str[n] = '\0';
 	return (str);
 }
-
-char	*ar_add_char_to_str(t_arena *arena, char *s, char c)
-{
-	size_t	len;
-	char	*result;
-
-	if (!s)
-		len = 0;
-	else
-		len = ft_strlen(s);
-	result = (char *)ar_alloc(arena, len + 2);
-	if (!result)
-		return (NULL);
-	if (s)
-		ft_memcpy(result, s, len);
-	result[len] = c;
-	result[len + 1] = '\0';
-	return (result);
-}
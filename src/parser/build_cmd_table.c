@@ -12,37 +12,38 @@
 
 #include "minishell.h"
 
-/* Parses a linked list of tokens into a command table structure.
+/* Parses the token array into a command table structure, token by token.
 
 Builds a command table where:
 - Pipes (|) separate commands and increment the command count
 - Redirections (<, >, >>, <<) set redirection type and capture filename
 - Regular word tokens are added as command arguments
+- Leading VAR=value words of a command are moved out of its arguments
 
 Return: 0 on success, -1 on errors, 2 on syntax error
 */
-int	register_to_table(t_shell *shell, t_tokens *list_of_toks,
+int	register_to_table(t_shell *shell, t_token_list *toks,
 				t_cmd_table *table)
 {
-	t_tokens	*current_tok;
 	t_cmd		*current_cmd;
 	int			check;
 
-	if (list_of_toks == NULL)
+	if (toks == NULL)
 		return (-1);
-	current_tok = list_of_toks;
+	toks->pos = 0;
 	current_cmd = new_cmd_alloc(shell->arena);
 	if (!current_cmd)
 		return (err_msg_n_return_value("Memory alloc failed for t_cmd\n", -1));
 	table->list_of_cmds = current_cmd;
 	table->cmd_count = 1;
-	while (current_tok)
+	while (toks->pos < toks->count)
 	{
-		check = check_current_token(shell, current_tok, &current_cmd, table);
+		check = check_current_token(shell, toks, &current_cmd, table);
 		if (check == -1 || check == 2)
 			return (check);
-		current_tok = current_tok->next;
+		toks->pos++;
 	}
+	split_prefix_assignments(table);
 	return (0);
 }
 
@@ -56,26 +57,33 @@ t_cmd	*new_cmd_alloc(t_arena *arena)
 	if (!new)
 		return (NULL);
 	new->cmd_av = NULL;
+	new->cmd_ac = 0;
+	new->av_cap = 0;
+	new->assigns = NULL;
+	new->assign_count = 0;
 	new->redirections = NULL;
 	new->heredoc_filename = NULL;
 	new->next_cmd = NULL;
 	return (new);
 }
 
-/* Process tokens for building command table
+/* Process the token at toks->pos for building command table
 - Pipes: validate syntax then create a new t_cmd struct
 - Redirections: validate file name, then create redirection expansion
 - Words: pass to helper function for further processing
 
 Return: 0 on success, -1 on errors, 2 on syntax error
 */
-int	check_current_token(t_shell *shell, t_tokens *token, t_cmd **current_cmd,
-	t_cmd_table *table)
+int	check_current_token(t_shell *shell, t_token_list *toks,
+	t_cmd **current_cmd, t_cmd_table *table)
 {
+	t_token	*token;
+
+	token = &toks->items[toks->pos];
 	if (token->type == TOKEN_PIPE)
 	{
 		if (!((*current_cmd)->cmd_av || (*current_cmd)->redirections)
-			|| !token->next)
+			|| toks->pos + 1 == toks->count)
 			return (err_msg_n_return_value("Syntax error around pipe\n", 2));
 		(*current_cmd)->next_cmd = new_cmd_alloc(shell->arena);
 		if (!(*current_cmd)->next_cmd)
@@ -87,15 +95,13 @@ int	check_current_token(t_shell *shell, t_tokens *token, t_cmd **current_cmd,
 	}
 	else if (is_redirection(token->type))
 	{
-		if (!token->next || token->next->type != TOKEN_WORD)
+		if (toks->pos + 1 == toks->count || token[1].type != TOKEN_WORD)
 			return (err_msg_n_return_value("Syntax error around redirection\n",
 					2));
-		if (make_redir(shell, token, *current_cmd) == -1)
-			return (-1);
-		return (0);
+		return (make_redir(shell, toks, *current_cmd));
 	}
 	else
-		return (check_token_word(shell, token, *current_cmd));
+		return (check_token_word(shell, toks, *current_cmd));
 }
 
 void	*err_msg_n_return_null(char *msg)
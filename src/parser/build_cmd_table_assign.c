@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   build_cmd_table_assign.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: gita <gita@student.hive.fi>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 16:12:40 by gita              #+#    #+#             */
+/*   Updated: 2025/11/08 16:12:42 by gita             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Check if a word, as it was typed, is an assignment: a valid name, not
+quoted and not coming from an expansion, followed by =
+("A=1" and A="x y" are, "A"=1, $X=1 and 1A=1 are not). The lexer runs it
+on the span of each word (see token_flags()); the span ends at a blank or
+an operator, never at a =, so reading past it can not find one.
+
+Return: 1 if it is, 0 if it is not
+*/
+int	is_assignment_word(char *word)
+{
+	int	i;
+
+	if (!(ft_isalpha(word[0]) || word[0] == '_'))
+		return (0);
+	i = 1;
+	while (ft_isalnum(word[i]) || word[i] == '_')
+		i++;
+	return (word[i] == '=');
+}
+
+/* Move the VAR=value words in front of each command out of its arguments,
+into cmd->assigns. They only go to the env of that command (see
+apply_env_overlay()), the variables of the shell are not touched.
+The vector is not copied: assigns keeps its start, cmd_av starts after it.
+A command made of assignments only is left as it is.
+*/
+void	split_prefix_assignments(t_cmd_table *table)
+{
+	t_cmd	*cmd;
+
+	cmd = table->list_of_cmds;
+	while (cmd)
+	{
+		if (cmd->assign_count && cmd->assign_count < cmd->cmd_ac)
+		{
+			cmd->assigns = cmd->cmd_av;
+			cmd->cmd_av += cmd->assign_count;
+			cmd->cmd_ac -= cmd->assign_count;
+			cmd->av_cap -= cmd->assign_count;
+		}
+		else
+			cmd->assign_count = 0;
+		cmd = cmd->next_cmd;
+	}
+}
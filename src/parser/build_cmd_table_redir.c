@@ -30,27 +30,29 @@ Otherwise, strips quotes from delimiter and sets expansion flag
 **
 ** Return: 0 on success, -1 on errors
 */
-static int	setup_redir_filename(t_shell *shell, t_tokens *tok,
+static int	setup_redir_filename(t_shell *shell, t_token_list *toks,
 			t_redir *new)
 {
+	t_token	*tok;
+	char	*value;
+
+	tok = &toks->items[toks->pos];
+	value = toks->text + tok->off;
 	if (new->tok_type == TOKEN_HEREDOC)
 	{
-		new->expand_heredoc = !tok->was_quoted;
-		if (ft_strchr(tok->value, '$') || ft_strchr(tok->value, '&'))
-			new->filename = special_heredoc_delimiter(shell->arena, tok->value);
+		new->expand_heredoc = !(tok->flags & TOK_QUOTED);
+		if (tok->flags & TOK_EXPANDS)
+			new->filename = special_heredoc_delimiter(shell->arena, value);
 		else
 		{
-			new->filename = ar_strdup(shell->arena, tok->value);
+			new->filename = ar_strdup(shell->arena, value);
 			if (!new->filename)
 				return (err_msg_n_return_value("strdup failed for heredoc eof "
 						"with no expansion\n", -1));
 		}
 	}
-	else
-	{
-		if (work_on_filename(shell, tok, &new->filename) == -1)
-			return (-1);
-	}
+	else if (work_on_filename(shell, toks, &new->filename) == -1)
+		return (-1);
 	if (!new->filename || new->filename[0] == 0)
 		return (err_msg_n_return_value("Minishell: No such file or directory\n",
 				-1));
@@ -61,13 +63,13 @@ static int	setup_redir_filename(t_shell *shell, t_tokens *tok,
 
 - Allocate memory for a new t_redir structure
 - Set redirection type from current token
-- Move to next token and ar_strdup the filename
+- Move toks->pos to the filename token and set up the filename
 - Appends the new t_redir to the command's redirection list.
 	If no redirection exists, it becomes the first node; otherwise at the end.
 
 Return: 0 on success, -1 on errors
 */
-int	make_redir(t_shell *shell, t_tokens *curr_tok, t_cmd *curr_cmd)
+int	make_redir(t_shell *shell, t_token_list *toks, t_cmd *curr_cmd)
 {
 	t_redir	*new;
 	t_redir	*find_tail;
@@ -75,10 +77,10 @@ int	make_redir(t_shell *shell, t_tokens *curr_tok, t_cmd *curr_cmd)
 	new = ar_alloc(shell->arena, sizeof(t_redir));
 	if (!new)
 		return (err_msg_n_return_value("Mem alloc failed for t_redir\n", -1));
-	set_redir_type(curr_tok->type, &new->tok_type);
+	set_redir_type(toks->items[toks->pos].type, &new->tok_type);
 	new->next = NULL;
-	*curr_tok = *curr_tok->next;
-	if (setup_redir_filename(shell, curr_tok, new) == -1)
+	toks->pos++;
+	if (setup_redir_filename(shell, toks, new) == -1)
 		return (-1);
 	if (!curr_cmd->redirections)
 		curr_cmd->redirections = new;
@@ -107,19 +109,22 @@ void	set_redir_type(t_token_type tok_type, t_token_type *redir_type)
 		*redir_type = TOKEN_HEREDOC;
 }
 
-/* Copy the string of the token to be the file name. Expand variables if any.
+/* The string of the token at toks->pos is the file name, with variables
+expanded if any. Both live in the arena as long as the table, no copy needed.
 Return: 0 on success, -1 on errors
 */
-int	work_on_filename(t_shell *shell, t_tokens *tok_name, char **name)
+int	work_on_filename(t_shell *shell, t_token_list *toks, char **name)
 {
-	if (ft_strchr(tok_name->value, '$') || ft_strchr(tok_name->value, '&'))
+	t_token	*tok;
+	char	*value;
+
+	tok = &toks->items[toks->pos];
+	value = toks->text + tok->off;
+	if (tok->flags & TOK_EXPANDS)
 	{
-		if (expand_variable_name(shell, &tok_name->value, 1) == -1)
+		if (expand_variable_name(shell, &value, 1) == -1)
 			return (-1);
 	}
-	*name = ar_strdup(shell->arena, tok_name->value);
-	if (!*name)
-		return (err_msg_n_return_value("strdup failed for redir filename\n",
-				-1));
+	*name = value;
 	return (0);
 }
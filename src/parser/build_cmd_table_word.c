@@ -12,27 +12,42 @@
 
 #include "minishell.h"
 
-/* Process word token and build the current command
+/* Process the word token at toks->pos and build the current command
 - Validate if it is a word token
 - Check if the string is just "&" or "&&" (these are not supported)
 - If there is $ present, pass to helper function to expand variable name
-- Add the value (can correctly be NULL) to the current command arguments
+- Drop a value that is empty unless the word was quoted, and add the rest to
+the current command arguments. NULL is never stored, it would end argv.
+- Count it as a prefix assignment if it is a VAR=value word and only such
+words came before it (see split_prefix_assignments())
 
 Return: 0 on success, -1 on errors
 */
-int	check_token_word(t_shell *shell, t_tokens *token, t_cmd *current_cmd)
+int	check_token_word(t_shell *shell, t_token_list *toks, t_cmd *current_cmd)
 {
+	t_token	*token;
+	char	*value;
+
+	token = &toks->items[toks->pos];
+	value = toks->text + token->off;
 	if (token->type != TOKEN_WORD)
 		return (err_msg_n_return_value("Not a word token\n", -1));
-	if (ft_strcmp(token->value, "&") == 0 || ft_strcmp(token->value, "&&") == 0)
+	if (ft_strcmp(value, "&") == 0 || ft_strcmp(value, "&&") == 0)
 		return (err_msg_n_return_value("& and && not supported\n", -1));
-	if (ft_strchr(token->value, '$') || ft_strchr(token->value, '&'))
-		if (expand_variable_name(shell, &token->value, 0) == -1)
+	if (token->flags & TOK_EXPANDS)
+		if (expand_variable_name(shell, &value, 0) == -1)
 			return (-1);
-	if ((!token->value || !token->value[0]) && !token->was_quoted)
+	if ((!value || !value[0]) && !(token->flags & TOK_QUOTED))
 		return (0);
-	if (add_argv(shell->arena, current_cmd, token->value) == -1)
+	if (!value)
+		value = ar_alloc(shell->arena, 1);
+	if (!value)
+		return (err_msg_n_return_value("Memalloc failed for argument\n", -1));
+	if (add_argv(shell->arena, current_cmd, value) == -1)
 		return (-1);
+	if (current_cmd->assign_count == current_cmd->cmd_ac - 1
+		&& (token->flags & TOK_ASSIGN))
+		current_cmd->assign_count++;
 	return (0);
 }
 
@@ -41,24 +56,36 @@ int	check_token_word(t_shell *shell, t_tokens *token, t_cmd *current_cmd)
 - Enter single/double quote mode and exit only when seeing the same quote
 - Variable expansion according to the mode (in single quote or other modes)
 - Other characters are added to the final string
+- Only the final string is kept, scratch memory used while building it
+(variable names, $? digits, outgrown buffers) is rolled back out of the arena
+- Arena use in here is attributed to the expand phase
+- The result is never NULL: a word that expands to nothing ($NOPE, $"")
+gives an empty string, callers decide if that is still a word
 
 Return: 0 on success, -1 on errors
 */
 int	expand_variable_name(t_shell *shell, char **original_string, int in_redir)
 {
-	char	*expanded_text;
+	char		*expanded_text;
+	t_ar_str	builder;
+	t_ar_mark	mark;
+	t_ar_phase	phase;
 
-	expanded_text = NULL;
-	if (go_thru_input(shell, *original_string, &expanded_text) == -1)
-		return (-1);
-	if (in_redir)
-	{
-		if (expanded_text[0] == 0)
-			return (err_msg_n_return_value("Ambiguous redirect\n", -1));
-		if (var_in_redir_outside_2xquotes(*original_string) == 1)
-			if (ft_strchr(expanded_text, ' '))
-				return (err_msg_n_return_value("Ambiguous redirect\n", -1));
-	}
+	ft_bzero(&builder, sizeof(t_ar_str));
+	phase = ar_set_phase(shell->arena, AR_EXPAND);
+	mark = ar_mark(shell->arena);
+	if (ar_str_reserve(shell->arena, &builder, 0) == -1
+		|| go_thru_input(shell, *original_string, &builder) == -1)
+		return (ar_rollback(shell->arena, mark),
+			ar_set_phase(shell->arena, phase), -1);
+	expanded_text = ar_rollback_keep(shell->arena, mark, builder.buf);
+	ar_set_phase(shell->arena, phase);
+	if (!expanded_text)
+		return (err_msg_n_return_value("Memalloc failed for expansion\n", -1));
+	if (in_redir && (expanded_text[0] == 0
+			|| (var_in_redir_outside_2xquotes(*original_string) == 1
+				&& ft_strchr(expanded_text, ' '))))
+		return (err_msg_n_return_value("Ambiguous redirect\n", -1));
 	*original_string = expanded_text;
 	return (0);
 }
@@ -97,48 +124,54 @@ int	var_in_redir_outside_2xquotes(char *tok_value)
 	return (0);
 }
 
-/* Expand command array to include a new token value:
- - Allocating new array with space for existing arguments + new argument + NULL
- - Give existing string pointers to new array
- - Use ar_strdup() to duplicate the new token value into the array
- - Add NULL terminator to the expanded array
- - Update the old command array with the new allocation
+/* Double the capacity of the argument vector (or give it a first one).
+While nothing else was allocated after the vector, it simply grows in place,
+otherwise it is copied once to a new block.
+(helper function of add_argv())
 
- Return: 0 on success, -1 on errors
+Return: 0 on success, -1 on errors
 */
-int	add_argv(t_arena *arena, t_cmd *command, char *expansion)
+static int	grow_argv(t_arena *arena, t_cmd *command)
 {
-	size_t	quantity;
-	size_t	i;
-	char	**new_cmd_av;
+	char	**bigger;
+	size_t	old_size;
+	int		new_cap;
 
-	quantity = 0;
-	if (command->cmd_av)
-		while (command->cmd_av[quantity])
-			quantity++;
-	new_cmd_av = ar_alloc(arena, (quantity + 2) * sizeof(char *));
-	if (!new_cmd_av)
-		return (err_msg_n_return_value("Allocation for command failed\n", -1));
-	i = 0;
+	new_cap = ARGV_FIRST_CAP;
+	if (command->av_cap)
+		new_cap = command->av_cap * 2;
+	old_size = command->av_cap * sizeof(char *);
+	if (command->cmd_av && ar_extend(arena, command->cmd_av, old_size,
+			new_cap * sizeof(char *)))
+	{
+		command->av_cap = new_cap;
+		return (0);
+	}
+	bigger = ar_alloc(arena, new_cap * sizeof(char *));
+	if (!bigger)
+		return (-1);
 	if (command->cmd_av)
-		get_old_argv(command->cmd_av, new_cmd_av, &i);
-	new_cmd_av[i] = ar_strdup(arena, expansion);
-	if (!new_cmd_av[i])
-		return (err_msg_n_return_value("strdup fail while building command\n",
-				-1));
-	new_cmd_av[i + 1] = NULL;
-	command->cmd_av = new_cmd_av;
+		ft_memcpy(bigger, command->cmd_av, old_size);
+	command->cmd_av = bigger;
+	command->av_cap = new_cap;
 	return (0);
 }
 
-/* Give the new cmd_av the same arguments the old cmd_av have
-(helper function of add_argv())
+/* Append a new value to the argument vector of the command:
+ - The vector has room for av_cap pointers, cmd_ac arguments + NULL in use
+ - When it is full the capacity doubles, so N words cost O(N) in total
+ - The value is stored as it is: it is already arena memory (the token text
+ or the result of the expansion) that lives as long as the table. It must not
+ be NULL, that is where argv ends
+
+ Return: 0 on success, -1 on errors
 */
-void	get_old_argv(char **old, char **new, size_t *i)
+int	add_argv(t_arena *arena, t_cmd *command, char *expansion)
 {
-	while (old[*i])
-	{
-		new[*i] = old[*i];
-		(*i)++;
-	}
+	if (command->cmd_ac + 1 >= command->av_cap
+		&& grow_argv(arena, command) == -1)
+		return (err_msg_n_return_value("Allocation for command failed\n", -1));
+	command->cmd_av[command->cmd_ac++] = expansion;
+	command->cmd_av[command->cmd_ac] = NULL;
+	return (0);
 }
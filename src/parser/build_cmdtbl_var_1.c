@@ -12,32 +12,68 @@
 
 #include "minishell.h"
 
-/* Iterate through the input string and rewrite the input into expand_text
+/* Copy the run of bytes up to the next $, quote or the end of the input as
+it is, the run is found with scan_until()
+Return: 0 on success, -1 on errors
+(helper function of go_thru_input())
+*/
+static int	copy_plain_run(t_arena *arena, t_ar_str *text, char *input,
+		size_t *i)
+{
+	size_t	run;
+
+	run = scan_until(input + *i, SCAN_EXPAND);
+	if (run && ar_str_putn(arena, text, input + *i, run) == -1)
+		return (err_msg_n_return_value("Error building string\n", -1));
+	*i += run;
+	return (0);
+}
+
+/* A $ right before a quote is no variable. Inside double quotes it stays a
+plain $ ("$" prints $), outside of quotes it is dropped ($"x" prints x).
+The quote mode is the one carried by go_thru_input(), so nothing is rescanned
+Return: 0 on success, -1 on errors
+(helper function of go_thru_input())
+*/
+static int	dollar_before_quote(t_arena *arena, t_ar_str *text, int in_quote)
+{
+	if (in_quote && ar_str_putc(arena, text, '$') == -1)
+		return (err_msg_n_return_value("Error adding $ to str\n", -1));
+	return (0);
+}
+
+/* Single pass over the token value that removes the quotes and expands the
+variables into expand_text, with the quote mode carried along
+- Plain text between $ signs and quotes is copied in one go
 - If the character is $ and not in single quote mode, enter expansion function
 - Otherwise, enter generic function for other cases
 
 Return: 0 on success, -1 on errors
 */
-int	go_thru_input(t_shell *shell, char *input, char **expand_text)
+int	go_thru_input(t_shell *shell, char *input, t_ar_str *expand_text)
 {
 	size_t	i;
 	int		in_quote;
+	int		check;
 
 	i = 0;
 	in_quote = 0;
 	while (input[i])
 	{
-		if (input[i] == '$' && in_quote != 1)
-		{
-			if (dollar_sign_encounter(shell, input, &i, expand_text) == -1)
-				return (-1);
-		}
+		if (copy_plain_run(shell->arena, expand_text, input, &i) == -1)
+			return (-1);
+		if (!input[i])
+			break ;
+		if (input[i] == '$' && in_quote != 1
+			&& (input[i + 1] == '"' || input[i + 1] == '\''))
+			check = dollar_before_quote(shell->arena, expand_text, in_quote);
+		else if (input[i] == '$' && in_quote != 1)
+			check = dollar_sign_encounter(shell, input, &i, expand_text);
 		else
-		{
-			if (other_character(shell->arena, expand_text, input[i],
-					&in_quote) == -1)
-				return (-1);
-		}
+			check = other_character(shell->arena, expand_text, input[i],
+					&in_quote);
+		if (check == -1)
+			return (-1);
 		i++;
 	}
 	return (0);
@@ -50,7 +86,7 @@ quote mode only if it's the same quote
 
 Return: 0 on success, -1 on errors
 */
-int	other_character(t_arena *arena, char **expand_text, char current_char,
+int	other_character(t_arena *arena, t_ar_str *expand_text, char current_char,
 		int *in_quote)
 {
 	if ((current_char == '\"' || current_char == '\'') && !*in_quote)
@@ -66,8 +102,7 @@ int	other_character(t_arena *arena, char **expand_text, char current_char,
 		*in_quote = 0;
 	else
 	{
-		*expand_text = ar_add_char_to_str(arena, *expand_text, current_char);
-		if (!*expand_text)
+		if (ar_str_putc(arena, expand_text, current_char) == -1)
 			return (err_msg_n_return_value("Error building string\n", -1));
 	}
 	return (0);
@@ -15,19 +15,17 @@
 /* When encounter a $, enter helper function to extract the variable name 
 - If there is a valid variable name,
 pass the variable name to helper function for expansion.
-- If no variable name, depends on the situation to add the lonely $ 
-to the string in build or not
+- If no variable name, add the lonely $ to the string in build
 
 Return: 0 on success, -1 on errors
 */
-int	dollar_sign_encounter(t_shell *shell, char *input, size_t *i, char **text)
+int	dollar_sign_encounter(t_shell *shell, char *input, size_t *i,
+		t_ar_str *text)
 {
 	char	*var_name;
-	int		check;
 
 	var_name = NULL;
-	check = build_var_name(shell, input, i, &var_name);
-	if (check == -1)
+	if (build_var_name(shell, input, i, &var_name) == -1)
 		return (-1);
 	if (var_name)
 	{
@@ -36,73 +34,37 @@ int	dollar_sign_encounter(t_shell *shell, char *input, size_t *i, char **text)
 	}
 	else
 	{
-		if (check != 1)
-		{
-			*text = ar_add_char_to_str(shell->arena, *text, '$');
-			if (!*text)
-				return (err_msg_n_return_value("Error adding $ to str\n", -1));
-		}
+		if (ar_str_putc(shell->arena, text, '$') == -1)
+			return (err_msg_n_return_value("Error adding $ to str\n", -1));
 	}
 	return (0);
 }
 
 /* Build the variable name that contains alphanumeric or _ characters,
-or only one ? after the $. No building if a quote is found after $ and enter
-helper function to decide to print out $ or not
+or only one ? after the $. The name is measured first and copied once.
+($ followed by a quote never gets here, see go_thru_input())
 
-Return: 1 when $ should NOT be printed, 0 when $ should be printed or
-variable name was built successfully, -1 on errors
+Return: 0 when $ should be printed or variable name was built successfully,
+-1 on errors
 */
 int	build_var_name(t_shell *shell, char *input, size_t *i, char **var_name)
 {
-	int	print_sign;
+	size_t	start;
 
-	if (input[*i + 1] == '"' || input[*i + 1] == '\'')
-	{
-		print_sign = check_dollar_sign_position(input, i);
-		if (print_sign == 0)
-			return (1);
-		if (print_sign == 1)
-			return (0);
-	}
+	start = *i + 1;
 	while (ft_isalnum(input[*i + 1]) || input[*i + 1] == '_'
 		|| input[*i + 1] == '?')
 	{
-		*var_name = ar_add_char_to_str(shell->arena, *var_name, input[*i + 1]);
-		if (!*var_name)
-			return (err_msg_n_return_value("Error building var name\n", -1));
 		(*i)++;
-		if (*var_name[0] == '?' && input[*i + 1])
-			return (0);
-	}
-	return (0);
-}
-
-/* 0 = do not print, 1 = print
-*/
-int	check_dollar_sign_position(char *input, size_t *i)
-{
-	size_t	p;
-	int		in_quotes;
-	char	quote;
-
-	p = 0;
-	in_quotes = 0;
-	while (input[p] && p <= *i)
-	{
-		if (!in_quotes && (input[p] == '"' || input[p] == '\''))
-		{
-			in_quotes = 1;
-			quote = input[p];
-		}
-		else if (in_quotes && input[p] == quote)
-			in_quotes = 0;
-		p++;
+		if (input[start] == '?' && input[*i + 1])
+			break ;
 	}
-	if (in_quotes)
-		return (1);
-	else
+	if (*i + 1 == start)
 		return (0);
+	*var_name = ar_substr(shell->arena, input, start, *i + 1 - start);
+	if (!*var_name)
+		return (err_msg_n_return_value("Error building var name\n", -1));
+	return (0);
 }
 
 /* Find the value of the variable name passed to the function,
@@ -111,7 +73,7 @@ then add that value to the string in building
 
 Return: 0 on success, -1 on errors
 */
-int	transform_var_name(t_shell *shell, char **text, char *var_name)
+int	transform_var_name(t_shell *shell, t_ar_str *text, char *var_name)
 {
 	char	*var_value;
 
@@ -124,8 +86,7 @@ int	transform_var_name(t_shell *shell, char **text, char *var_name)
 	}
 	else
 		var_value = get_shell_env_value(shell, var_name);
-	*text = ar_strjoin(shell->arena, *text, var_value);
-	if (!*text)
+	if (ar_str_puts(shell->arena, text, var_value) == -1)
 		return (err_msg_n_return_value("Error in joining variable to string\n",
 				-1));
 	return (0);
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lexer.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: gita <gita@student.hive.fi>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/07 11:02:36 by gita              #+#    #+#             */
+/*   Updated: 2025/11/07 11:02:38 by gita             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Two operator characters that do not form an operator together ("<>",
+">|", ...) are a syntax error on the second one
+
+Return: 2 (syntax error)
+*/
+static int	lex_syntax_error(t_shell *shell, int cls)
+{
+	shell->last_exit_status = 2;
+	if (cls == CC_PIPE)
+		return (err_msg_n_return_value("Syntax error near |\n", 2));
+	if (cls == CC_LESS)
+		return (err_msg_n_return_value("Syntax error near <\n", 2));
+	return (err_msg_n_return_value("Syntax error near >\n", 2));
+}
+
+/* Advance over a word: stop at whitespace or an operator outside of quotes.
+Runs of plain bytes are skipped with scan_until(), the class table only
+decides about the byte the run stopped at.
+Quotes are only tracked here, they are kept in the span. The flags tell the
+token builder whether quotes have to be removed and whether the word still
+has to go through variable expansion ($ or &, quoted or not).
+
+Return: 0 on success, -1 for an unclosed quote
+*/
+static int	scan_word(t_lex *lex)
+{
+	unsigned char	cls;
+	char			quote;
+
+	quote = 0;
+	while (1)
+	{
+		lex->pos += scan_until(lex->input + lex->pos, quote != 0);
+		cls = g_char_class[(unsigned char)lex->input[lex->pos]];
+		if (cls == CC_END && quote)
+			return (err_msg_n_return_value("Unclosed quote\n", -1));
+		if (cls == CC_DOLLAR || cls == CC_AMP)
+			lex->expands = 1;
+		else if (quote && lex->input[lex->pos] == quote)
+			quote = 0;
+		else if (!quote && (cls == CC_SQUOTE || cls == CC_DQUOTE))
+		{
+			quote = lex->input[lex->pos];
+			lex->quoted = 1;
+		}
+		else if (!quote && cls >= CC_SPACE)
+			return (0);
+		lex->pos++;
+	}
+}
+
+/* Operators are |, <, <<, > and >>. An operator character right after a
+single < or > that does not double it is a syntax error. A quote right
+after | glues the pipe to the following word, which then becomes a word
+token (kept from the previous tokenizer).
+
+Return: 0 on success, -1 on errors, 2 for syntax error
+*/
+static int	scan_operator(t_shell *shell, t_lex *lex, int cls)
+{
+	int	next;
+
+	lex->pos++;
+	next = g_char_class[(unsigned char)lex->input[lex->pos]];
+	if (cls == CC_PIPE && (next == CC_SQUOTE || next == CC_DQUOTE))
+		return (scan_word(lex));
+	lex->type = TOKEN_PIPE;
+	if (cls == CC_PIPE)
+		return (0);
+	if (next == cls)
+	{
+		lex->pos++;
+		lex->type = TOKEN_APPEND;
+		if (cls == CC_LESS)
+			lex->type = TOKEN_HEREDOC;
+		return (0);
+	}
+	if (next == CC_PIPE || next == CC_LESS || next == CC_GREAT)
+		return (lex_syntax_error(shell, next));
+	lex->type = TOKEN_REDIRECT_OUT;
+	if (cls == CC_LESS)
+		lex->type = TOKEN_REDIRECT_IN;
+	return (0);
+}
+
+/*
+** lex_next_token - Find the next token of the input line
+**
+** DESCRIPTION:
+**   Single pass, table driven lexer. Skips whitespace, then scans one
+**   operator or word and records its span (start, pos), type and flags
+**   in lex. Nothing is allocated here, the token value is built from the
+**   span afterwards (see push_token()).
+**
+** PARAMETERS:
+**   shell - Shell state (exit status on syntax errors)
+**   lex   - Lexer state, pos is where the previous token ended
+**
+** RETURN VALUE:
+**   Returns 1 if a token was found, 0 at the end of the line, -1 on errors
+*/
+int	lex_next_token(t_shell *shell, t_lex *lex)
+{
+	int	cls;
+
+	while (g_char_class[(unsigned char)lex->input[lex->pos]] == CC_SPACE)
+		lex->pos++;
+	cls = g_char_class[(unsigned char)lex->input[lex->pos]];
+	if (cls == CC_END)
+		return (0);
+	lex->start = lex->pos;
+	lex->type = TOKEN_WORD;
+	lex->quoted = 0;
+	lex->expands = 0;
+	if (cls == CC_PIPE || cls == CC_LESS || cls == CC_GREAT)
+	{
+		if (scan_operator(shell, lex, cls) != 0)
+			return (-1);
+	}
+	else if (scan_word(lex) == -1)
+		return (-1);
+	return (1);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: gita <gita@student.hive.fi>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 13:20:11 by gita              #+#    #+#             */
+/*   Updated: 2025/11/08 13:20:13 by gita             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+/* Class of every byte, so the lexer and scan_until() decide with one lookup
+what a character does. Everything not listed is an ordinary word character
+(CC_WORD).
+*/
+const unsigned char	g_char_class[256] = {
+[0] = CC_END, ['\t'] = CC_SPACE, ['\n'] = CC_SPACE, [' '] = CC_SPACE,
+['"'] = CC_DQUOTE, ['$'] = CC_DOLLAR, ['&'] = CC_AMP, ['\''] = CC_SQUOTE,
+['<'] = CC_LESS, ['>'] = CC_GREAT, ['|'] = CC_PIPE};
+
+/* Reference kernel, one byte at a time. Used where no vector kernel exists
+and as the oracle the vector kernels are tested against.
+
+Return: index of the first byte of s that is in stops or is the NUL
+*/
+size_t	scan_scalar(const char *s, const char *stops)
+{
+	size_t	i;
+	size_t	j;
+
+	i = 0;
+	while (s[i])
+	{
+		j = 0;
+		while (stops[j] && stops[j] != s[i])
+			j++;
+		if (stops[j])
+			return (i);
+		i++;
+	}
+	return (i);
+}
+
+/* Choose the widest kernel the CPU supports, once
+(helper function of scan_until())
+*/
+static t_scan_fn	pick_kernel(void)
+{
+	int	level;
+
+	level = scan_cpu_level();
+	if (level >= 2)
+		return (scan_avx2);
+	if (level == 1)
+		return (scan_sse2);
+	return (scan_scalar);
+}
+
+/*
+** scan_until - Skip a run of uninteresting bytes
+**
+** DESCRIPTION:
+**   Finds the first byte of s that belongs to the stop set, or the
+**   terminating NUL. The lexer, the expansion pass and heredoc expansion
+**   use it to jump over plain text and to copy it in one go.
+**   Most runs on a command line are short, so the first SCAN_PREFIX bytes
+**   are checked with the class table. Longer runs go to the AVX2 (32 bytes
+**   per step), SSE2 (16 bytes) or scalar kernel picked at the first call.
+**
+** PARAMETERS:
+**   s   - NUL-terminated string to scan
+**   set - SCAN_WORD, SCAN_QUOTED, SCAN_EXPAND or SCAN_DOLLAR
+**
+** RETURN VALUE:
+**   Returns the length of the run, 0 if s already points at a stop byte
+*/
+size_t	scan_until(const char *s, t_scan_set set)
+{
+	static t_scan_fn	kernel;
+	static const char	*stops[SCAN_SETS] = {SCAN_WORD_STOPS,
+		SCAN_QUOTED_STOPS, SCAN_EXPAND_STOPS, SCAN_DOLLAR_STOPS};
+	static const int	masks[SCAN_SETS] = {SCAN_WORD_MASK,
+		SCAN_QUOTED_MASK, SCAN_EXPAND_MASK, SCAN_DOLLAR_MASK};
+	size_t				i;
+
+	i = 0;
+	while (i < SCAN_PREFIX
+		&& !((1 << g_char_class[(unsigned char)s[i]]) & masks[set]))
+		i++;
+	if (i < SCAN_PREFIX)
+		return (i);
+	if (!kernel)
+		kernel = pick_kernel();
+	return (i + kernel(s + i, stops[set]));
+}
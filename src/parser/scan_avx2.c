@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan_avx2.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: gita <gita@student.hive.fi>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 14:06:30 by gita              #+#    #+#             */
+/*   Updated: 2025/11/08 14:06:31 by gita             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+#if defined(__x86_64__)
+
+# include <immintrin.h>
+
+/* Same scheme as scan_sse2(), 32 bytes per step. Only called when
+scan_cpu_level() found AVX2, the target attribute lets the rest of the
+build stay at the baseline instruction set.
+*/
+
+/* Same as match16() on an aligned 32-byte block
+*/
+__attribute__((target("avx2"), no_sanitize_address))
+static unsigned int	match32(const char *p, __m256i *needles, int count)
+{
+	__m256i	block;
+	__m256i	hits;
+	int		j;
+
+	block = _mm256_load_si256((const __m256i *)p);
+	hits = _mm256_cmpeq_epi8(block, needles[0]);
+	j = 1;
+	while (j < count)
+	{
+		hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[j]));
+		j++;
+	}
+	return ((unsigned int)_mm256_movemask_epi8(hits));
+}
+
+__attribute__((target("avx2")))
+size_t	scan_avx2(const char *s, const char *stops)
+{
+	__m256i			needles[SCAN_MAX_STOPS + 1];
+	const char		*p;
+	unsigned int	mask;
+	int				count;
+
+	needles[0] = _mm256_setzero_si256();
+	count = 1;
+	while (stops[count - 1] && count <= SCAN_MAX_STOPS)
+	{
+		needles[count] = _mm256_set1_epi8(stops[count - 1]);
+		count++;
+	}
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)31);
+	mask = match32(p, needles, count) & (0xFFFFFFFFu << (s - p));
+	while (!mask)
+	{
+		p += 32;
+		mask = match32(p, needles, count);
+	}
+	return ((size_t)(p + __builtin_ctz(mask) - s));
+}
+
+#else
+
+size_t	scan_avx2(const char *s, const char *stops)
+{
+	return (scan_scalar(s, stops));
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan_sse2.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: gita <gita@student.hive.fi>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/08 13:41:52 by gita              #+#    #+#             */
+/*   Updated: 2025/11/08 13:41:54 by gita             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minishell.h"
+
+#if defined(__x86_64__)
+
+# include <immintrin.h>
+
+/* Vector kernels only ever load whole aligned blocks. A block holding the
+first byte of s or the NUL never crosses a page, so reading the bytes around
+the string inside that block is safe. Bytes before s are masked out.
+*/
+
+/* 0 = scalar only, 1 = SSE2, 2 = AVX2 (SSE2 is part of x86-64)
+*/
+int	scan_cpu_level(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return (2);
+	return (1);
+}
+
+/* Bit i set when byte i of the aligned 16-byte block p matches one of the
+count needles (the NUL and the broadcast stop bytes). The block may run past
+the end of the string, which is harmless as it never crosses a page, but
+AddressSanitizer would flag it, hence the attribute.
+*/
+__attribute__((no_sanitize_address))
+static unsigned int	match16(const char *p, __m128i *needles, int count)
+{
+	__m128i	block;
+	__m128i	hits;
+	int		j;
+
+	block = _mm_load_si128((const __m128i *)p);
+	hits = _mm_cmpeq_epi8(block, needles[0]);
+	j = 1;
+	while (j < count)
+	{
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[j]));
+		j++;
+	}
+	return ((unsigned int)_mm_movemask_epi8(hits));
+}
+
+size_t	scan_sse2(const char *s, const char *stops)
+{
+	__m128i			needles[SCAN_MAX_STOPS + 1];
+	const char		*p;
+	unsigned int	mask;
+	int				count;
+
+	needles[0] = _mm_setzero_si128();
+	count = 1;
+	while (stops[count - 1] && count <= SCAN_MAX_STOPS)
+	{
+		needles[count] = _mm_set1_epi8(stops[count - 1]);
+		count++;
+	}
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)15);
+	mask = match16(p, needles, count) & (0xFFFFu << (s - p));
+	while (!mask)
+	{
+		p += 16;
+		mask = match16(p, needles, count);
+	}
+	return ((size_t)(p + __builtin_ctz(mask) - s));
+}
+
+#else
+
+/* No vector kernels on this architecture, scan_until() stays scalar
+*/
+int	scan_cpu_level(void)
+{
+	return (0);
+}
+
+size_t	scan_sse2(const char *s, const char *stops)
+{
+	return (scan_scalar(s, stops));
+}
+
+#endif
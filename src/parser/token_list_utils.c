@@ -12,50 +12,132 @@
 
 #include "minishell.h"
 
-t_tokens	*create_token(t_arena *arena, char *word)
+/* Start an empty token array for a line of input_len bytes.
+The values of all tokens go to one text buffer that is sized once: a value
+is never longer than its span of the line, spans do not overlap, and every
+value gets a NUL, so the line length twice is always enough.
+Values are copied there rather than pointing into the line, because the
+parser wants them NUL-terminated and without their quotes, and the line
+itself is left as readline gave it.
+
+Return: the token list, NULL on errors
+*/
+t_token_list	*new_token_list(t_arena *arena, size_t input_len)
 {
-	t_tokens	*token;
-
-	token = ar_alloc(arena, sizeof(t_tokens));
-	if (!token)
-		return (NULL);
-	token->value = ar_strdup(arena, word);
-	if (!token->value)
-		return (NULL);
-	token->type = get_token_type(word);
-	token->was_quoted = 0;
-	token->next = NULL;
-	return (token);
+	t_token_list	*toks;
+
+	toks = ar_alloc(arena, sizeof(t_token_list));
+	if (!toks)
+		return (err_msg_n_return_null("Memalloc failed for token list\n"));
+	toks->text = ar_alloc(arena, input_len * 2 + 1);
+	toks->items = ar_alloc(arena, TOK_FIRST_CAP * sizeof(t_token));
+	if (!toks->text || !toks->items)
+		return (err_msg_n_return_null("Memalloc failed for tokens\n"));
+	toks->cap = TOK_FIRST_CAP;
+	return (toks);
 }
 
-t_token_type	get_token_type(char *str)
+/* Double the capacity of the token array. While nothing else was allocated
+after the array, it simply grows in place, otherwise it is copied once.
+(helper function of push_token())
+
+Return: 0 on success, -1 on errors
+*/
+static int	grow_tokens(t_arena *arena, t_token_list *toks)
 {
-	if (!str)
-		return (TOKEN_EOF);
-	if (ft_strcmp(str, "|") == 0)
-		return (TOKEN_PIPE);
-	if (ft_strcmp(str, "<") == 0)
-		return (TOKEN_REDIRECT_IN);
-	if (ft_strcmp(str, ">") == 0)
-		return (TOKEN_REDIRECT_OUT);
-	if (ft_strcmp(str, ">>") == 0)
-		return (TOKEN_APPEND);
-	if (ft_strcmp(str, "<<") == 0)
-		return (TOKEN_HEREDOC);
-	return (TOKEN_WORD);
+	t_token	*bigger;
+	size_t	old_size;
+
+	old_size = toks->cap * sizeof(t_token);
+	if (!ar_extend(arena, toks->items, old_size, old_size * 2))
+	{
+		bigger = ar_alloc(arena, old_size * 2);
+		if (!bigger)
+			return (err_msg_n_return_value("Memalloc failed for tokens\n",
+					-1));
+		ft_memcpy(bigger, toks->items, old_size);
+		toks->items = bigger;
+	}
+	toks->cap *= 2;
+	return (0);
 }
 
-void	add_to_end(t_tokens **head, t_tokens *new_node)
+/* Copy a quoted word without its quotes: a quote opens a quoted part, the
+same quote closes it, everything else is kept. The lexer already made sure
+every quote is closed.
+(helper function of push_token())
+
+Return: length of the unquoted value
+*/
+static int	unquote_span(char *dest, char *span, int len)
 {
-	t_tokens	*tmp;
+	char	quote;
+	int		i;
+	int		j;
 
-	if (!*head)
+	quote = 0;
+	i = 0;
+	j = 0;
+	while (i < len)
 	{
-		*head = new_node;
-		return ;
+		if (!quote && (span[i] == '"' || span[i] == '\''))
+			quote = span[i];
+		else if (quote && span[i] == quote)
+			quote = 0;
+		else
+			dest[j++] = span[i];
+		i++;
 	}
-	tmp = *head;
-	while (tmp->next)
-		tmp = tmp->next;
-	tmp->next = new_node;
+	return (j);
+}
+
+/* Flags of the token the lexer just found. Whether a word is an assignment
+is decided here, on the span as it was typed: once its quotes are removed,
+"A"=1 could not be told from A=1.
+(helper function of push_token())
+*/
+static int	token_flags(t_lex *lex)
+{
+	int	flags;
+
+	flags = 0;
+	if (lex->quoted)
+		flags |= TOK_QUOTED;
+	if (lex->expands)
+		flags |= TOK_EXPANDS;
+	if (lex->type == TOKEN_WORD && is_assignment_word(lex->input + lex->start))
+		flags |= TOK_ASSIGN;
+	return (flags);
+}
+
+/* Append the span the lexer just found to the token array
+- Operators and plain words are copied to the text buffer as they are
+- Quoted words without $ or & lose their quotes right away
+- Words with $ or & keep their quotes, expansion removes them later
+The text buffer is zeroed arena memory, so the value is already terminated.
+
+Return: 0 on success, -1 on errors
+*/
+int	push_token(t_arena *arena, t_token_list *toks, t_lex *lex)
+{
+	t_token	*tok;
+	char	*span;
+	int		len;
+
+	if (toks->count == toks->cap && grow_tokens(arena, toks) == -1)
+		return (-1);
+	tok = &toks->items[toks->count++];
+	tok->type = lex->type;
+	tok->flags = token_flags(lex);
+	tok->off = toks->text_len;
+	span = lex->input + lex->start;
+	len = lex->pos - lex->start;
+	if (lex->quoted && !lex->expands)
+		tok->len = unquote_span(toks->text + tok->off, span, len);
+	else
+		tok->len = len;
+	if (!lex->quoted || lex->expands)
+		ft_memcpy(toks->text + tok->off, span, len);
+	toks->text_len += tok->len + 1;
+	return (0);
 }
@@ -13,131 +13,42 @@
 #include "minishell.h"
 
 /*
-** tokenize_input - Enhanced tokenizer for shell input parsing
+** tokenize_input - Tokenizer for shell input parsing
 **
 ** DESCRIPTION:
 **   Performs lexical analysis on shell input, breaking it into tokens.
 **   Handles operators (|, <, >, >>, <<), quoted strings, and words.
-**   Skips whitespace and provides proper error handling.
+**   The lexer (lex_next_token()) finds one token span at a time and the
+**   token is pushed to one growable array (see token_list_utils.c).
 **
 ** PARAMETERS:
-**   arena - Memory arena for allocations
+**   shell - Shell state structure (arena, exit status)
 **   input - The command line string to tokenize
 **
 ** RETURN VALUE:
-**   Returns a linked list of tokens (t_tokens *) or NULL on error
+**   Returns the token array, NULL on error or if the line has no token
 */
-t_tokens	*tokenize_input(t_shell *shell, char *input)
+t_token_list	*tokenize_input(t_shell *shell, char *input)
 {
-	t_tokens	*head;
-	int			i;
+	t_token_list	*toks;
+	t_lex			lex;
+	int				found;
 
 	if (!input || !*input)
 		return (NULL);
-	head = NULL;
-	i = 0;
-	while (input[i])
-	{
-		skip_whitespace(input, &i);
-		if (!input[i])
-			break ;
-		if (!process_single_token(shell, input, &i, &head))
-			return (NULL);
-	}
-	return (head);
-}
-
-void	skip_whitespace(char *input, int *i)
-{
-	while (input[*i] && (input[*i] == ' ' || input[*i] == '\t'))
-		(*i)++;
-}
-
-/*
-** process_single_token - Process one token and add it to the list
-**
-** DESCRIPTION:
-**   Extracts a single token from input, creates a token node,
-**   and adds it to the token list. Handles error cleanup.
-**
-** PARAMETERS:
-**   arena - Memory arena for allocations
-**   input - The input string
-**   i     - Pointer to current index (modified by reference)
-**   head  - Pointer to token list head (modified by reference)
-**
-** RETURN VALUE:
-**   Returns head of token list or NULL on error
-*/
-t_tokens	*process_single_token(t_shell *shell, char *input, int *i,
-		t_tokens **head)
-{
-	t_tokens	*new_token;
-	char		*token_value;
-	char		*pre_process_value;
-	int			start_i;
-
-	start_i = *i;
-	new_token = NULL;
-	token_value = extract_next_token(shell, input, i);
-	if (!token_value)
+	toks = new_token_list(shell->arena, ft_strlen(input));
+	if (!toks)
 		return (NULL);
-	new_token = create_token(shell->arena, token_value);
-	if (!new_token)
-		return (NULL);
-	pre_process_value = ft_substr(input, start_i, *i - start_i);
-	if (pre_process_value)
+	ft_bzero(&lex, sizeof(t_lex));
+	lex.input = input;
+	found = lex_next_token(shell, &lex);
+	while (found == 1)
 	{
-		new_token->was_quoted = has_quotes(pre_process_value);
-		if (new_token->type != TOKEN_WORD && new_token->was_quoted)
-			new_token->type = TOKEN_WORD;
-		free(pre_process_value);
+		if (push_token(shell->arena, toks, &lex) == -1)
+			return (NULL);
+		found = lex_next_token(shell, &lex);
 	}
-	add_to_end(head, new_token);
-	return (*head);
-}
-
-/*
-** extract_next_token - Main token extraction dispatcher
-**
-** DESCRIPTION:
-**   Determines the type of the next token and calls the appropriate
-**   extraction function. This is the main logic hub for tokenization.
-**
-** PARAMETERS:
-**   arena     - Memory arena for allocations
-**   input     - The input string
-**   i         - Pointer to current index (modified by reference)
-**
-** RETURN VALUE:
-**   Returns allocated string containing the token value or NULL on error
-*/
-char	*extract_next_token(t_shell *shell, char *input, int *i)
-{
-	char	*string;
-
-	string = NULL;
-	if (chop_up_input(shell, input, i, &string) == -1)
+	if (found == -1 || toks->count == 0)
 		return (NULL);
-	return (check_for_quoted_string(shell->arena, string));
-}
-
-/*
-** Check if the string has any quotes
-** Returns 1 if yes, 0 if no
-*/
-int	has_quotes(char *str)
-{
-	int	i;
-
-	if (!str)
-		return (0);
-	i = 0;
-	while (str[i])
-	{
-		if (str[i] == '\'' || str[i] == '"')
-			return (1);
-		i++;
-	}
-	return (0);
+	return (toks);
 }